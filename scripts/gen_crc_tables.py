@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# Generate CRC32 lookup tables for the parametric CRC engine.
+#
+# Each --variant is "name:poly:reflected:init:xorout", for example
+# "bzip2:0x04C11DB7:0:0xFFFFFFFF:0xFFFFFFFF". For every variant the script
+# emits crc32_<name>_table[slices][entries]. Non-reflected variants named with
+# --inv-table also get crc32_<name>_inv_table[slices][entries], the x^-1
+# tables used to walk the bzip2 reverse word order front-to-back.
+#
+# --entries 16 builds nibble tables (4 bits per lookup), --entries 256 byte
+# tables. --slices 8 adds the slicing-by-8 tables, --slices 1 only the base
+# table; this follows the CONFIG_CRC32_IMPL_* tier.
+
+import argparse
+import os
+
+
+def reflect32(v):
+    return int('{:032b}'.format(v)[::-1], 2)
+
+
+def msb_tables(poly, entries, slices):
+    bits = entries.bit_length() - 1
+    t0 = []
+    for i in range(entries):
+        c = i << (32 - bits)
+        for _ in range(bits):
+            c = ((c << 1) ^ poly) if c & 0x80000000 else (c << 1)
+            c &= 0xFFFFFFFF
+        t0.append(c)
+
+    tables = [t0]
+    for k in range(1, slices):
+        prev = tables[k - 1]
+        tables.append([((v << 8) & 0xFFFFFFFF) ^ t0[v >> 24] for v in prev])
+    return tables
+
+
+def lsb_tables(rpoly, entries, slices):
+    bits = entries.bit_length() - 1
+    t0 = []
+    for i in range(entries):
+        c = i
+        for _ in range(bits):
+            c = (c >> 1) ^ rpoly if c & 1 else c >> 1
+        t0.append(c)
+
+    tables = [t0]
+    for k in range(1, slices):
+        prev = tables[k - 1]
+        tables.append([(v >> 8) ^ t0[v & 0xFF] for v in prev])
+    return tables
+
+
+def parse_variant(spec):
+    name, poly, reflected, init, xorout = spec.split(':')
+    return {
+        'name': name,
+        'poly': int(poly, 0),
+        'reflected': int(reflected, 0) != 0,
+        'init': int(init, 0),
+        'xorout': int(xorout, 0),
+    }
+
+
+def format_tables(symbol, tables):
+    entries = len(tables[0])
+    rows = entries // 4
+    lines = ['const uint32_t {}[{}][{}] = {{'.format(symbol, len(tables), entries)]
+    for k, table in enumerate(tables):
+        lines.append('{')
+        for row in range(rows):
+            words = ', '.join('0x{:08x}'.format(v) for v in table[row * 4:row * 4 + 4])
+            lines.append('   ' + words + (',' if row < rows - 1 else ''))
+        lines.append('}' + (',' if k < len(tables) - 1 else ''))
+    lines.append('};')
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate CRC32 lookup tables')
+    parser.add_argument('--output-dir', required=True)
+    parser.add_argument('--variant', action='append', required=True,
+                        help='name:poly:reflected:init:xorout')
+    parser.add_argument('--inv-table', action='append', default=[],
+                        help='non-reflected variant that also needs x^-1 tables')
+    parser.add_argument('--entries', type=int, choices=[16, 256], default=256)
+    parser.add_argument('--slices', type=int, choices=[1, 8], default=8)
+    args = parser.parse_args()
+
+    if args.entries == 16 and args.slices != 1:
+        parser.error('nibble tables cannot be sliced')
+
+    entries = args.entries
+    slices = args.slices
+
+    variants = [parse_variant(v) for v in args.variant]
+
+    for name in args.inv_table:
+        if not any(v['name'] == name and not v['reflected'] for v in variants):
+            parser.error('--inv-table {}: no such non-reflected variant'.format(name))
+    banner = '/* Generated by scripts/gen_crc_tables.py, do not edit */'
+
+    header = [banner, '',
+              '#ifndef CRC32_TABLES_GEN_H',
+              '#define CRC32_TABLES_GEN_H', '',
+              '#include <stdint.h>', '',
+              '#define CRC32_TABLE_ENTRIES {}'.format(entries),
+              '#define CRC32_TABLE_SLICES {}'.format(slices), '']
+
+    source = [banner, '', '#include "crc32_tables_gen.h"', '']
+
+    for v in variants:
+        name = v['name']
+        decl = 'extern const uint32_t crc32_{}_{}[{}][{}];'
+        header.append(decl.format(name, 'table', slices, entries))
+
+        if v['reflected']:
+            source += format_tables('crc32_{}_table'.format(name),
+                                    lsb_tables(reflect32(v['poly']), entries, slices))
+        else:
+            source += format_tables('crc32_{}_table'.format(name),
+                                    msb_tables(v['poly'], entries, slices))
+
+        if name in args.inv_table:
+            header.append(decl.format(name, 'inv_table', slices, entries))
+            source.append('')
+            # Division by x: (poly >> 1) with the x^32 term landing in bit 31
+            source += format_tables('crc32_{}_inv_table'.format(name),
+                                    lsb_tables((v['poly'] >> 1) | 0x80000000, entries, slices))
+        source.append('')
+
+    header += ['', '/* X(name, poly, reflected, init, xorout) */',
+               '#define CRC32_GEN_VARIANTS(X) \\']
+    for v in variants:
+        header.append('    X({}, 0x{:08X}u, {}, 0x{:08X}u, 0x{:08X}u) \\'.format(
+            v['name'], v['poly'], 'true' if v['reflected'] else 'false',
+            v['init'], v['xorout']))
+    header += ['', '#endif /* CRC32_TABLES_GEN_H */', '']
+
+    os.makedirs(args.output_dir, exist_ok=True)
+    with open(os.path.join(args.output_dir, 'crc32_tables_gen.h'), 'w') as f:
+        f.write('\n'.join(header))
+    with open(os.path.join(args.output_dir, 'crc32_tables_gen.c'), 'w') as f:
+        f.write('\n'.join(source))
+
+
+if __name__ == '__main__':
+    main()
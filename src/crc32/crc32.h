@@ -1,13 +1,45 @@
-#ifndef CRC32_H
-#define CRC32_H
-
-#include <stdint.h>
-#include <stddef.h>
-
-void BZ2_initialise_crc (uint32_t *crc);
-
-void BZ2_finalise_crc (uint32_t *crc);
-
-void BZ2_update_crc (uint32_t *crc, uint8_t ch);
-
-#endif // CRC32_H
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+void BZ2_initialise_crc (uint32_t *crc);
+
+void BZ2_finalise_crc (uint32_t *crc);
+
+void BZ2_update_crc (uint32_t *crc, uint8_t ch);
+
+/* Process one word MSB-first, equivalent to four BZ2_update_crc() calls */
+void BZ2_update_crc_word (uint32_t *crc, uint32_t word);
+
+/* Process words from data[words_len - 1] down to data[0], each MSB-first */
+void BZ2_update_crc_words_rev (uint32_t *crc, const uint32_t *data, size_t words_len);
+
+/*
+ * Forward traversal of the same word order as BZ2_update_crc_words_rev().
+ * Start with acc = 0, feed the region from data[0] upwards in any number
+ * of calls, then BZ2_update_crc_fwd_finish() applies the result to the
+ * CRC register. Both steps together equal one BZ2_update_crc_words_rev()
+ * call over the whole region. Only built with CONFIG_CRC32_FORWARD_KERNEL.
+ */
+void BZ2_update_crc_words_fwd (uint32_t *acc, const uint32_t *data, size_t words_len);
+
+void BZ2_update_crc_fwd_finish (uint32_t *crc, uint32_t acc, size_t words_len);
+
+/*
+ * Combine two finalised CRCs: returns the CRC of block1 followed by
+ * block2, given crc1 = CRC(block1), crc2 = CRC(block2) and the length
+ * of block2 in bytes.
+ */
+uint32_t crc32_combine (uint32_t crc1, uint32_t crc2, size_t len2);
+
+/* Precompute the shift operator for len2 bytes, for repeated combines */
+uint32_t crc32_combine_gen (size_t len2);
+
+uint32_t crc32_combine_op (uint32_t crc1, uint32_t crc2, uint32_t op);
+
+/* a * b modulo the CRC polynomial, bit n holding the coefficient of x^n */
+uint32_t crc32_multmodp (uint32_t a, uint32_t b);
+
+#endif // CRC32_H
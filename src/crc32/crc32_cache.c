@@ -0,0 +1,293 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#ifdef CONFIG_CRC32_CACHE_SETTINGS
+#include <zephyr/settings/settings.h>
+#endif
+#include <string.h>
+#include "crc32_cache.h"
+#include "crc32.h"
+
+LOG_MODULE_REGISTER(crc32_cache);
+
+#define CRC32_CACHE_MAGIC 0x48435243u /* "CRCH" */
+#define CRC32_CACHE_SETTINGS_KEY "crc32/cache"
+
+/*
+ * Lives in a __noinit section so it survives warm resets. With
+ * CONFIG_CRC32_CACHE_SETTINGS it is also saved to the settings store on
+ * every change and loaded on first use, so it survives power cycles too.
+ * Otherwise the contents are random after a cold boot; the magic and the
+ * CRC over the table reject them and the cache starts empty.
+ */
+struct crc32_cache
+{
+    uint32_t magic;
+    uint32_t next;          /* slot replaced when the table is full */
+    struct crc32_cache_entry entries[CRC32_CACHE_ENTRIES];
+    uint32_t crc;           /* over everything above */
+};
+
+K_MUTEX_DEFINE(crc_cache_lock);
+
+static __noinit struct crc32_cache m_cache;
+
+#ifdef CONFIG_CRC32_CACHE_SETTINGS
+static bool m_loaded;
+
+static int cache_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+                              void *cb_arg)
+{
+    const char *next;
+
+    if (!settings_name_steq(name, "cache", &next) || next != NULL)
+    {
+        return -ENOENT;
+    }
+
+    /* A table of another layout fails the CRC check instead */
+    if (len != sizeof(m_cache))
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&crc_cache_lock, K_FOREVER);
+    ssize_t rc = read_cb(cb_arg, &m_cache, sizeof(m_cache));
+    k_mutex_unlock(&crc_cache_lock);
+
+    return (rc < 0) ? (int)rc : 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(crc32_cache, "crc32", NULL, cache_settings_set, NULL, NULL);
+
+/* Called with crc_cache_lock held */
+static void cache_load(void)
+{
+    if (m_loaded)
+    {
+        return;
+    }
+
+    m_loaded = true;
+
+    int err = settings_subsys_init();
+
+    if (err == 0)
+    {
+        err = settings_load_subtree("crc32");
+    }
+
+    if (err < 0)
+    {
+        LOG_WRN("Loading the cache failed (%d), using RAM only", err);
+    }
+}
+
+/* Called with crc_cache_lock held, after cache_seal() */
+static void cache_store(void)
+{
+    int err = settings_save_one(CRC32_CACHE_SETTINGS_KEY, &m_cache, sizeof(m_cache));
+
+    if (err < 0)
+    {
+        LOG_WRN("Saving the cache failed (%d)", err);
+    }
+}
+#else
+static void cache_load(void)
+{
+}
+
+static void cache_store(void)
+{
+}
+#endif
+
+static uint32_t cache_crc(void)
+{
+    return crc32_bzip2_words((const uint32_t *)&m_cache,
+                             offsetof(struct crc32_cache, crc) / sizeof(uint32_t));
+}
+
+static void cache_seal(void)
+{
+    m_cache.crc = cache_crc();
+}
+
+static void cache_validate(void)
+{
+    cache_load();
+
+    if (m_cache.magic != CRC32_CACHE_MAGIC || m_cache.crc != cache_crc() ||
+        m_cache.next >= CRC32_CACHE_ENTRIES)
+    {
+        memset(&m_cache, 0, sizeof(m_cache));
+        m_cache.magic = CRC32_CACHE_MAGIC;
+        cache_seal();
+    }
+}
+
+static uint32_t fingerprint(uint32_t address, size_t words_len, int mode)
+{
+    const uint32_t *data = (const uint32_t *)address;
+    size_t samples = MIN(words_len, (size_t)CRC32_CACHE_SAMPLES);
+    uint32_t crc;
+
+    BZ2_initialise_crc(&crc);
+
+    /* First and last word always, the rest evenly in between */
+    for (size_t i = 0; i < samples; i++)
+    {
+        size_t pos = (samples > 1) ? (i * (words_len - 1)) / (samples - 1) : 0;
+
+        BZ2_update_crc_word(&crc, data[pos]);
+    }
+
+    if (mode == 1)
+    {
+        BZ2_update_crc_word(&crc, data[words_len]);
+    }
+
+    BZ2_finalise_crc(&crc);
+    return crc;
+}
+
+static struct crc32_cache_entry *cache_find(uint32_t address, size_t words_len,
+                                            uint32_t image_id, int mode)
+{
+    for (size_t i = 0; i < CRC32_CACHE_ENTRIES; i++)
+    {
+        struct crc32_cache_entry *e = &m_cache.entries[i];
+
+        if (e->words != 0 && e->address == address && e->words == words_len &&
+            e->image_id == image_id && e->mode == (uint32_t)mode)
+        {
+            return e;
+        }
+    }
+
+    return NULL;
+}
+
+static struct crc32_cache_entry *cache_slot(void)
+{
+    for (size_t i = 0; i < CRC32_CACHE_ENTRIES; i++)
+    {
+        if (m_cache.entries[i].words == 0)
+        {
+            return &m_cache.entries[i];
+        }
+    }
+
+    struct crc32_cache_entry *e = &m_cache.entries[m_cache.next];
+
+    m_cache.next = (m_cache.next + 1) % CRC32_CACHE_ENTRIES;
+    return e;
+}
+
+struct crc_result crc32_words_check_cached(uint32_t address, size_t words_len, int mode,
+                                           uint32_t image_id, bool *hit)
+{
+    struct crc_result res = {0};
+    bool cached = false;
+
+    if (hit != NULL)
+    {
+        *hit = false;
+    }
+
+    if (!crc32_words_valid(address, words_len) || (mode != 0 && mode != 1))
+    {
+        res.status = CRC_INVALID;
+        return res;
+    }
+
+    uint32_t fp = fingerprint(address, words_len, mode);
+
+    k_mutex_lock(&crc_cache_lock, K_FOREVER);
+    cache_validate();
+
+    struct crc32_cache_entry *e = cache_find(address, words_len, image_id, mode);
+
+    if (e != NULL && e->fingerprint == fp)
+    {
+        res = crc32_words_result(address, words_len, mode, e->crc);
+        cached = true;
+    }
+
+    k_mutex_unlock(&crc_cache_lock);
+
+    if (cached)
+    {
+        if (hit != NULL)
+        {
+            *hit = true;
+        }
+
+        return res;
+    }
+
+    res = crc32_words_check(address, words_len, mode);
+
+    /* Only a passing check (or a plain mode 0 CRC) becomes the golden value */
+    if (res.status == CRC_FAIL)
+    {
+        return res;
+    }
+
+    k_mutex_lock(&crc_cache_lock, K_FOREVER);
+
+    e = cache_find(address, words_len, image_id, mode);
+    if (e == NULL)
+    {
+        e = cache_slot();
+    }
+
+    e->address = address;
+    e->words = words_len;
+    e->image_id = image_id;
+    e->crc = (mode == 1) ? res.crc_ref : res.crc;
+    e->fingerprint = fp;
+    e->mode = mode;
+    cache_seal();
+    cache_store();
+
+    k_mutex_unlock(&crc_cache_lock);
+
+    return res;
+}
+
+void crc32_cache_clear(void)
+{
+    k_mutex_lock(&crc_cache_lock, K_FOREVER);
+
+    cache_load();
+    memset(&m_cache, 0, sizeof(m_cache));
+    m_cache.magic = CRC32_CACHE_MAGIC;
+    cache_seal();
+    cache_store();
+
+    k_mutex_unlock(&crc_cache_lock);
+}
+
+int crc32_cache_entry_get(size_t index, struct crc32_cache_entry *entry)
+{
+    int err = -ENOENT;
+
+    if (index >= CRC32_CACHE_ENTRIES)
+    {
+        return -ENOENT;
+    }
+
+    k_mutex_lock(&crc_cache_lock, K_FOREVER);
+    cache_validate();
+
+    if (m_cache.entries[index].words != 0)
+    {
+        *entry = m_cache.entries[index];
+        err = 0;
+    }
+
+    k_mutex_unlock(&crc_cache_lock);
+
+    return err;
+}
@@ -0,0 +1,44 @@
+#ifndef CRC32_CACHE_H
+#define CRC32_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "crc32_test.h"
+
+#define CRC32_CACHE_ENTRIES 16
+/* Words read for the fingerprint, spread evenly over the region */
+#define CRC32_CACHE_SAMPLES 16
+
+/* One verified region, keyed by address, length, image ID and mode */
+struct crc32_cache_entry
+{
+    uint32_t address;
+    uint32_t words;
+    uint32_t image_id;
+    uint32_t crc;           /* computed CRC of the last full pass */
+    uint32_t fingerprint;   /* sampled words, plus the trailer in mode 1 */
+    uint32_t mode;
+};
+
+/*
+ * crc32_words_check() backed by a cache in __noinit RAM, which survives
+ * warm resets, and with CONFIG_CRC32_CACHE_SETTINGS in the settings store,
+ * which also survives power cycles. When an entry for
+ * (address, words_len, image_id) exists and the fingerprint still matches,
+ * the cached CRC is used instead of a full pass over the region; otherwise
+ * the region is hashed and, unless the check failed, stored for the next
+ * boot. The fingerprint only samples the region, so image_id must change
+ * whenever its contents may have changed (e.g. the image version). hit is
+ * optional.
+ */
+struct crc_result crc32_words_check_cached(uint32_t address, size_t words_len, int mode,
+                                           uint32_t image_id, bool *hit);
+
+/* Forget every entry, e.g. after a firmware update */
+void crc32_cache_clear(void);
+
+/* Copy entry index into *entry, -ENOENT for an empty or out of range slot */
+int crc32_cache_entry_get(size_t index, struct crc32_cache_entry *entry);
+
+#endif // CRC32_CACHE_H
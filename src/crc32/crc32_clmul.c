@@ -0,0 +1,121 @@
+#include "crc32_clmul.h"
+
+#ifdef CRC32_HAVE_CLMUL
+
+#include <cpuid.h>
+#include <immintrin.h>
+#include "crc32.h"
+
+/*
+ * Folding constants x^k mod 0x04C11DB7. A 128-bit block X = H * x^64 + L
+ * moved k bits further down the message becomes
+ * H * (x^(k + 64) mod P) + L * (x^k mod P).
+ */
+#define K_FOLD_128_HI 0xC5B9CD4Cu   /* x^192 */
+#define K_FOLD_128_LO 0xE8A45605u   /* x^128 */
+#define K_FOLD_512_HI 0x8833794Cu   /* x^576 */
+#define K_FOLD_512_LO 0xE6228B11u   /* x^512 */
+
+#define CLMUL_TARGET __attribute__((target("pclmul,sse2")))
+
+static int m_clmul_supported = -1;
+
+bool crc32_clmul_available(void)
+{
+    if (m_clmul_supported < 0)
+    {
+        unsigned int eax, ebx, ecx, edx;
+
+        m_clmul_supported = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                             (ecx & bit_PCLMUL) && (edx & bit_SSE2)) ? 1 : 0;
+    }
+
+    return m_clmul_supported == 1;
+}
+
+CLMUL_TARGET
+static inline __m128i fold(__m128i x, __m128i k, __m128i next)
+{
+    __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+    __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+CLMUL_TARGET
+static void clmul_fold_words_rev(uint32_t *crc, const uint32_t *data, size_t words_len)
+{
+    /*
+    * The bzip2 order hashes the highest address first and each word
+    * MSB-first, so on a little-endian host a plain 16-byte load from the
+    * top of the region already is the message polynomial, first bit in
+    * bit 127. Walk down in 16-byte blocks, four lanes at a time.
+    */
+    const __m128i k128 = _mm_set_epi64x(K_FOLD_128_HI, K_FOLD_128_LO);
+    const uint32_t *p = data + words_len - 4;
+    size_t blocks = words_len / 4;
+
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p),
+                               _mm_set_epi32((int)*crc, 0, 0, 0));
+    blocks--;
+
+    if (blocks >= 7)
+    {
+        const __m128i k512 = _mm_set_epi64x(K_FOLD_512_HI, K_FOLD_512_LO);
+        __m128i x1 = _mm_loadu_si128((const __m128i *)(p - 4));
+        __m128i x2 = _mm_loadu_si128((const __m128i *)(p - 8));
+        __m128i x3 = _mm_loadu_si128((const __m128i *)(p - 12));
+
+        p -= 12;
+        blocks -= 3;
+
+        while (blocks >= 4)
+        {
+            x0 = fold(x0, k512, _mm_loadu_si128((const __m128i *)(p - 4)));
+            x1 = fold(x1, k512, _mm_loadu_si128((const __m128i *)(p - 8)));
+            x2 = fold(x2, k512, _mm_loadu_si128((const __m128i *)(p - 12)));
+            x3 = fold(x3, k512, _mm_loadu_si128((const __m128i *)(p - 16)));
+            p -= 16;
+            blocks -= 4;
+        }
+
+        x0 = fold(x0, k128, x1);
+        x0 = fold(x0, k128, x2);
+        x0 = fold(x0, k128, x3);
+    }
+
+    while (blocks > 0)
+    {
+        p -= 4;
+        x0 = fold(x0, k128, _mm_loadu_si128((const __m128i *)p));
+        blocks--;
+    }
+
+    /*
+    * The folded block still has to be multiplied by x^32 and reduced;
+    * running its four words through the table kernel from a zero
+    * register does exactly that.
+    */
+    uint32_t w[4];
+    uint32_t c = 0;
+
+    _mm_storeu_si128((__m128i *)w, x0);
+    BZ2_update_crc_words_rev(&c, w, 4);
+
+    /* Words below the last full block */
+    BZ2_update_crc_words_rev(&c, data, (size_t)(p - data));
+    *crc = c;
+}
+
+bool crc32_clmul_update_words_rev(uint32_t *crc, const uint32_t *data, size_t words_len)
+{
+    if (words_len < CRC32_CLMUL_MIN_WORDS || !crc32_clmul_available())
+    {
+        return false;
+    }
+
+    clmul_fold_words_rev(crc, data, words_len);
+    return true;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef CRC32_CLMUL_H
+#define CRC32_CLMUL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Carry-less multiply folding kernel, native_sim on x86 hosts only */
+#if defined(CONFIG_CRC32_CLMUL) && (defined(__x86_64__) || defined(__i386__))
+#define CRC32_HAVE_CLMUL 1
+#endif
+
+/* Shorter regions are cheaper through the table kernel */
+#define CRC32_CLMUL_MIN_WORDS 64
+
+#ifdef CRC32_HAVE_CLMUL
+
+/* CPUID check for PCLMULQDQ, the result is cached after the first call */
+bool crc32_clmul_available(void);
+
+/*
+ * Same contract as BZ2_update_crc_words_rev(): process data[words_len - 1]
+ * down to data[0], each word MSB-first, starting from register *crc.
+ * Returns false without touching *crc when the CPU lacks PCLMULQDQ or the
+ * region is shorter than CRC32_CLMUL_MIN_WORDS; the caller then falls back
+ * to the table kernel.
+ */
+bool crc32_clmul_update_words_rev(uint32_t *crc, const uint32_t *data, size_t words_len);
+
+#else
+
+static inline bool crc32_clmul_available(void)
+{
+    return false;
+}
+
+static inline bool crc32_clmul_update_words_rev(uint32_t *crc, const uint32_t *data,
+                                                size_t words_len)
+{
+    (void)crc;
+    (void)data;
+    (void)words_len;
+    return false;
+}
+
+#endif
+
+#endif // CRC32_CLMUL_H
@@ -0,0 +1,188 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+#include "crc32_engine.h"
+
+#define CRC32_VARIANT_DEFINE(_name, _poly, _reflected, _init, _xorout) \
+    const struct crc32_variant crc32_variant_##_name = {               \
+        .name = #_name,                                                 \
+        .poly = _poly,                                                  \
+        .init = _init,                                                  \
+        .xorout = _xorout,                                              \
+        .reflected = _reflected,                                        \
+        .table = crc32_##_name##_table,                                 \
+    };
+
+CRC32_GEN_VARIANTS(CRC32_VARIANT_DEFINE)
+
+#define CRC32_VARIANT_REF(name, poly, reflected, init, xorout) &crc32_variant_##name,
+
+static const struct crc32_variant *const variants[] = {
+    CRC32_GEN_VARIANTS(CRC32_VARIANT_REF)
+};
+
+const struct crc32_variant *crc32_variant_find(const char *name)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(variants); i++)
+    {
+        if (strcmp(name, variants[i]->name) == 0)
+        {
+            return variants[i];
+        }
+    }
+
+    return NULL;
+}
+
+const struct crc32_variant *crc32_variant_get(size_t index)
+{
+    if (index >= ARRAY_SIZE(variants))
+    {
+        return NULL;
+    }
+
+    return variants[index];
+}
+
+static uint32_t update_msb(const crc32_table_t *t, uint32_t crc,
+                           const uint8_t *p, size_t len)
+{
+    while (len >= 8)
+    {
+        crc = crc32_msb_word2(t, crc, sys_get_be32(p), sys_get_be32(p + 4));
+        p += 8;
+        len -= 8;
+    }
+
+    while (len > 0)
+    {
+        crc = crc32_msb_byte(t, crc, *p++);
+        len--;
+    }
+
+    return crc;
+}
+
+static uint32_t update_lsb(const crc32_table_t *t, uint32_t crc,
+                           const uint8_t *p, size_t len)
+{
+    while (len >= 8)
+    {
+        crc = crc32_lsb_word2(t, crc, sys_get_le32(p), sys_get_le32(p + 4));
+        p += 8;
+        len -= 8;
+    }
+
+    while (len > 0)
+    {
+        crc = crc32_lsb_byte(t, crc, *p++);
+        len--;
+    }
+
+    return crc;
+}
+
+uint32_t crc32_engine_init(const struct crc32_variant *v)
+{
+    return v->init;
+}
+
+uint32_t crc32_engine_update(const struct crc32_variant *v, uint32_t crc,
+                             const void *data, size_t len)
+{
+    if (v->reflected)
+    {
+        return update_lsb(v->table, crc, data, len);
+    }
+
+    return update_msb(v->table, crc, data, len);
+}
+
+uint32_t crc32_engine_final(const struct crc32_variant *v, uint32_t crc)
+{
+    return crc ^ v->xorout;
+}
+
+uint32_t crc32_engine_compute(const struct crc32_variant *v, const void *data, size_t len)
+{
+    uint32_t crc = crc32_engine_init(v);
+
+    crc = crc32_engine_update(v, crc, data, len);
+
+    return crc32_engine_final(v, crc);
+}
+
+static uint32_t reflect32(uint32_t v)
+{
+    uint32_t r = 0;
+
+    for (int i = 0; i < 32; i++)
+    {
+        r = (r << 1) | (v & 1u);
+        v >>= 1;
+    }
+
+    return r;
+}
+
+/*
+ * a * b modulo the variant polynomial, in the variant's register layout:
+ * bit 31 is x^31 for MSB-first variants and x^0 for reflected ones.
+ */
+static uint32_t multmodp(const struct crc32_variant *v, uint32_t a, uint32_t b)
+{
+    uint32_t p = 0;
+
+    if (v->reflected)
+    {
+        uint32_t rpoly = reflect32(v->poly);
+
+        for (uint32_t m = 0x80000000u; m != 0; m >>= 1)
+        {
+            if (a & m)
+            {
+                p ^= b;
+            }
+
+            b = (b & 1u) ? ((b >> 1) ^ rpoly) : (b >> 1);
+        }
+
+        return p;
+    }
+
+    for (uint32_t m = 0x80000000u; m != 0; m >>= 1)
+    {
+        p = (p << 1) ^ ((p & 0x80000000u) ? v->poly : 0);
+
+        if (a & m)
+        {
+            p ^= b;
+        }
+    }
+
+    return p;
+}
+
+uint32_t crc32_engine_combine(const struct crc32_variant *v, uint32_t crc1, uint32_t crc2,
+                              size_t len2)
+{
+    uint32_t op = v->reflected ? 0x80000000u : 0x00000001u;   /* x^0 */
+    uint32_t sq = v->reflected ? 0x00800000u : 0x00000100u;   /* x^8 */
+
+    while (len2 != 0)
+    {
+        if (len2 & 1u)
+        {
+            op = multmodp(v, op, sq);
+        }
+
+        sq = multmodp(v, sq, sq);
+        len2 >>= 1;
+    }
+
+    /*
+    * Shifting crc1 past block2 also shifts init and xorout; the init of
+    * block2 is already part of crc2, so both cancel out of crc1 first.
+    */
+    return multmodp(v, op, crc1 ^ v->xorout ^ v->init) ^ crc2;
+}
@@ -0,0 +1,48 @@
+#ifndef CRC32_ENGINE_H
+#define CRC32_ENGINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "crc32_tier.h"
+
+/*
+ * Parametric CRC32 engine. Variants are listed in crc32_tables.cmake and
+ * their tables are generated at build time, so every variant runs the
+ * same kernels of the configured CONFIG_CRC32_IMPL_* tier.
+ */
+struct crc32_variant
+{
+    const char *name;
+    uint32_t poly;
+    uint32_t init;
+    uint32_t xorout;
+    bool reflected;
+    const crc32_table_t *table;
+};
+
+#define CRC32_VARIANT_DECLARE(name, poly, reflected, init, xorout) \
+    extern const struct crc32_variant crc32_variant_##name;
+
+CRC32_GEN_VARIANTS(CRC32_VARIANT_DECLARE)
+
+/* Returns NULL for unknown names */
+const struct crc32_variant *crc32_variant_find(const char *name);
+
+/* Iterate variants for listing, returns NULL past the last one */
+const struct crc32_variant *crc32_variant_get(size_t index);
+
+uint32_t crc32_engine_init(const struct crc32_variant *v);
+
+uint32_t crc32_engine_update(const struct crc32_variant *v, uint32_t crc,
+                             const void *data, size_t len);
+
+uint32_t crc32_engine_final(const struct crc32_variant *v, uint32_t crc);
+
+uint32_t crc32_engine_compute(const struct crc32_variant *v, const void *data, size_t len);
+
+/* CRC of block1 followed by block2 from their finalised CRCs */
+uint32_t crc32_engine_combine(const struct crc32_variant *v, uint32_t crc1, uint32_t crc2,
+                              size_t len2);
+
+#endif // CRC32_ENGINE_H
@@ -0,0 +1,89 @@
+#include <zephyr/kernel.h>
+#include <string.h>
+#include "crc32_fused.h"
+#include "crc32_engine.h"
+#include "crc32.h"
+
+K_MUTEX_DEFINE(crc_fused_lock);
+
+static uint32_t m_block[CRC32_FUSED_BLOCK_WORDS];
+
+struct crc_fused_result crc32_words_check_fused(uint32_t address, size_t words_len, int mode,
+                                                unsigned int digests)
+{
+    struct crc_fused_result res = {0};
+
+    if (!crc32_words_valid(address, words_len) || (digests & CRC32_DIGEST_ALL) == 0 ||
+        (mode != 0 && mode != 1))
+    {
+        res.status = CRC_INVALID;
+        return res;
+    }
+
+    const uint32_t *data = (const uint32_t *)address;
+    uint32_t bz_crc;
+    uint32_t bz_acc = 0;
+    uint32_t c_crc = crc32_engine_init(&crc32_variant_c);
+    struct sha256_ctx sha;
+
+    BZ2_initialise_crc(&bz_crc);
+    sha256_init(&sha);
+
+    k_mutex_lock(&crc_fused_lock, K_FOREVER);
+
+    for (size_t pos = 0; pos < words_len; pos += CRC32_FUSED_BLOCK_WORDS)
+    {
+        size_t n = MIN(words_len - pos, (size_t)CRC32_FUSED_BLOCK_WORDS);
+        size_t bytes = n * sizeof(uint32_t);
+
+        /* The only read of the region, the digests work on the copy */
+        memcpy(m_block, &data[pos], bytes);
+
+        if (digests & CRC32_DIGEST_BZIP2)
+        {
+            BZ2_update_crc_words_fwd(&bz_acc, m_block, n);
+        }
+
+        if (digests & CRC32_DIGEST_CRC32C)
+        {
+            c_crc = crc32_engine_update(&crc32_variant_c, c_crc, m_block, bytes);
+        }
+
+        if (digests & CRC32_DIGEST_SHA256)
+        {
+            sha256_update(&sha, m_block, bytes);
+        }
+    }
+
+    k_mutex_unlock(&crc_fused_lock);
+
+    res.digests = digests & CRC32_DIGEST_ALL;
+
+    if (digests & CRC32_DIGEST_CRC32C)
+    {
+        res.crc32c = crc32_engine_final(&crc32_variant_c, c_crc);
+    }
+
+    if (digests & CRC32_DIGEST_SHA256)
+    {
+        sha256_final(&sha, res.sha256);
+    }
+
+    if (digests & CRC32_DIGEST_BZIP2)
+    {
+        BZ2_update_crc_fwd_finish(&bz_crc, bz_acc, words_len);
+        BZ2_finalise_crc(&bz_crc);
+
+        struct crc_result r = crc32_words_result(address, words_len, mode, bz_crc);
+
+        res.crc = r.crc;
+        res.crc_ref = r.crc_ref;
+        res.status = r.status;
+    }
+    else
+    {
+        res.status = CRC_UNUSED;
+    }
+
+    return res;
+}
@@ -0,0 +1,41 @@
+#ifndef CRC32_FUSED_H
+#define CRC32_FUSED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crc32_test.h"
+#include "sha256.h"
+
+/* Digests computed by crc32_words_check_fused() */
+#define CRC32_DIGEST_BZIP2  0x1u
+#define CRC32_DIGEST_CRC32C 0x2u
+#define CRC32_DIGEST_SHA256 0x4u
+#define CRC32_DIGEST_ALL    (CRC32_DIGEST_BZIP2 | CRC32_DIGEST_CRC32C | CRC32_DIGEST_SHA256)
+
+/* Region is copied to RAM in blocks of this size, read once per pass */
+#define CRC32_FUSED_BLOCK_WORDS 256
+
+/*
+ * crc_result extended with the other digests. crc, crc_ref and status
+ * follow crc32_words_check() for the bzip2 CRC; without CRC32_DIGEST_BZIP2
+ * status is CRC_UNUSED.
+ */
+struct crc_fused_result
+{
+    uint32_t crc;
+    uint32_t crc_ref;
+    enum crc_status status;
+    unsigned int digests;
+    uint32_t crc32c;
+    uint8_t sha256[SHA256_DIGEST_SIZE];
+};
+
+/*
+ * Read the region once, front to back, and feed every requested digest
+ * from the same buffered block. The bzip2 CRC keeps its reverse word order
+ * through the forward kernel.
+ */
+struct crc_fused_result crc32_words_check_fused(uint32_t address, size_t words_len, int mode,
+                                                unsigned int digests);
+
+#endif // CRC32_FUSED_H
@@ -0,0 +1,167 @@
+#include <zephyr/kernel.h>
+#include <string.h>
+#include "crc32_index.h"
+#include "crc32.h"
+
+static inline size_t block_len(const struct crc32_index *idx, size_t b)
+{
+    /* Only the last block can be short */
+    if (b == idx->blocks - 1)
+    {
+        return idx->words - b * idx->block_words;
+    }
+
+    return idx->block_words;
+}
+
+static inline uint32_t block_hash(const struct crc32_index *idx, size_t b)
+{
+    const uint32_t *data = (const uint32_t *)idx->address;
+
+    return crc32_bzip2_words(&data[b * idx->block_words], block_len(idx, b));
+}
+
+static void index_combine(struct crc32_index *idx)
+{
+    /*
+    * The region is hashed from its last word down, so the last block comes
+    * first in the message; every block before it is appended as a full
+    * block.
+    */
+    uint32_t crc = idx->block_crc[idx->blocks - 1];
+
+    for (size_t b = idx->blocks - 1; b > 0; b--)
+    {
+        crc = crc32_combine_op(crc, idx->block_crc[b - 1], idx->combine_op);
+    }
+
+    idx->crc = crc;
+}
+
+int crc32_index_build(struct crc32_index *idx, uint32_t address, size_t words_len,
+                      size_t block_words)
+{
+    if (!crc32_words_valid(address, words_len) || block_words == 0)
+    {
+        return -EINVAL;
+    }
+
+    size_t blocks = DIV_ROUND_UP(words_len, block_words);
+
+    if (blocks > idx->max_blocks)
+    {
+        return -EINVAL;
+    }
+
+    idx->address = address;
+    idx->words = words_len;
+    idx->block_words = block_words;
+    idx->blocks = blocks;
+    idx->sample_next = 0;
+    idx->combine_op = crc32_combine_gen(block_words * sizeof(uint32_t));
+
+    for (size_t b = 0; b < blocks; b++)
+    {
+        idx->block_crc[b] = block_hash(idx, b);
+    }
+
+    memset(idx->dirty, 0, DIV_ROUND_UP(blocks, 32) * sizeof(uint32_t));
+    index_combine(idx);
+
+    return 0;
+}
+
+int crc32_index_mark_dirty(struct crc32_index *idx, size_t offset, size_t len)
+{
+    size_t bytes = idx->words * sizeof(uint32_t);
+
+    if (len == 0 || offset >= bytes || len > bytes - offset)
+    {
+        return -EINVAL;
+    }
+
+    size_t block_bytes = idx->block_words * sizeof(uint32_t);
+    size_t last = (offset + len - 1) / block_bytes;
+
+    for (size_t b = offset / block_bytes; b <= last; b++)
+    {
+        idx->dirty[b / 32] |= 1u << (b % 32);
+    }
+
+    return 0;
+}
+
+size_t crc32_index_refresh(struct crc32_index *idx)
+{
+    size_t hashed = 0;
+
+    for (size_t w = 0; w < DIV_ROUND_UP(idx->blocks, 32); w++)
+    {
+        uint32_t bits = idx->dirty[w];
+
+        while (bits != 0)
+        {
+            size_t b = w * 32 + (size_t)(find_lsb_set(bits) - 1);
+
+            idx->block_crc[b] = block_hash(idx, b);
+            bits &= bits - 1;
+            hashed++;
+        }
+
+        idx->dirty[w] = 0;
+    }
+
+    if (hashed != 0)
+    {
+        index_combine(idx);
+    }
+
+    return hashed;
+}
+
+size_t crc32_index_sample(struct crc32_index *idx, size_t count)
+{
+    size_t mismatches = 0;
+
+    if (idx->blocks == 0)
+    {
+        return 0;
+    }
+
+    count = MIN(count, idx->blocks);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t b = idx->sample_next;
+        uint32_t crc = block_hash(idx, b);
+
+        if (crc != idx->block_crc[b])
+        {
+            idx->block_crc[b] = crc;
+            mismatches++;
+        }
+
+        idx->sample_next = (b + 1 == idx->blocks) ? 0 : b + 1;
+    }
+
+    if (mismatches != 0)
+    {
+        index_combine(idx);
+    }
+
+    return mismatches;
+}
+
+struct crc_result crc32_index_check(struct crc32_index *idx, int mode)
+{
+    if (idx->blocks == 0)
+    {
+        struct crc_result res = { .status = CRC_INVALID };
+
+        return res;
+    }
+
+    crc32_index_refresh(idx);
+
+    return crc32_words_result(idx->address, idx->words, mode, idx->crc);
+}
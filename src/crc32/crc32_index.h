@@ -0,0 +1,68 @@
+#ifndef CRC32_INDEX_H
+#define CRC32_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crc32_test.h"
+
+#define CRC32_INDEX_BLOCK_WORDS_DEFAULT 1024    /* 4 KiB blocks */
+
+/*
+ * Per-block CRCs of a region. Each block CRC is a complete bzip2 CRC of its
+ * words; the region CRC is derived from them with crc32_combine(), so after
+ * a partial update only the dirty blocks have to be read again.
+ */
+struct crc32_index
+{
+    uint32_t address;
+    size_t words;
+    size_t block_words;
+    size_t blocks;
+    size_t max_blocks;
+    uint32_t *block_crc;        /* max_blocks entries */
+    uint32_t *dirty;            /* DIV_ROUND_UP(max_blocks, 32) words */
+    uint32_t combine_op;        /* shift by one full block */
+    size_t sample_next;         /* next block for crc32_index_sample() */
+    uint32_t crc;               /* region CRC as of the last refresh */
+};
+
+/* Static storage for an index over up to max_blocks blocks */
+#define CRC32_INDEX_DEFINE(name, n_blocks)                      \
+    static uint32_t name##_block_crc[n_blocks];                 \
+    static uint32_t name##_dirty[DIV_ROUND_UP(n_blocks, 32)];   \
+    static struct crc32_index name = {                          \
+        .block_crc = name##_block_crc,                          \
+        .dirty = name##_dirty,                                  \
+        .max_blocks = n_blocks,                                 \
+    }
+
+/*
+ * Describe address/words with block_words per block and hash every block.
+ * Returns -EINVAL for invalid regions or more blocks than max_blocks.
+ */
+int crc32_index_build(struct crc32_index *idx, uint32_t address, size_t words_len,
+                      size_t block_words);
+
+/* Mark the blocks touched by len bytes at byte offset from the region start */
+int crc32_index_mark_dirty(struct crc32_index *idx, size_t offset, size_t len);
+
+/*
+ * Re-hash the dirty blocks and update the region CRC. Returns the number of
+ * blocks that were read.
+ */
+size_t crc32_index_refresh(struct crc32_index *idx);
+
+/*
+ * Re-hash count blocks round-robin and compare them with the stored CRCs.
+ * Changed blocks are updated as if they were dirty. Returns the number of
+ * blocks that did not match.
+ */
+size_t crc32_index_sample(struct crc32_index *idx, size_t count);
+
+/*
+ * crc32_words_check() for an indexed region: refresh, then build the result
+ * from the combined CRC. mode 1 still reads the trailing CRC word.
+ */
+struct crc_result crc32_index_check(struct crc32_index *idx, int mode);
+
+#endif // CRC32_INDEX_H
@@ -0,0 +1,430 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include "crc32_job.h"
+#include "crc32_job_transport.h"
+#include "crc32_stream.h"
+#include "crc32_engine.h"
+
+LOG_MODULE_REGISTER(crc32_job);
+
+/* Client side: one slot per job in flight */
+struct job_slot
+{
+    uint32_t id;
+    crc32_job_cb_t cb;
+    void *user_data;
+    uint32_t bytes;
+    uint32_t submitted;
+    bool used;
+};
+
+K_MUTEX_DEFINE(crc_job_client_lock);
+
+static struct job_slot m_slots[CRC32_JOB_QUEUE_LEN];
+static uint32_t m_next_id = 1;
+static struct crc32_job_stats m_stats;
+static bool m_ready;
+
+/* Executor side */
+K_MSGQ_DEFINE(crc_job_exec_queue, sizeof(struct crc32_job_msg), CRC32_JOB_QUEUE_LEN, 4);
+K_THREAD_STACK_DEFINE(crc_job_exec_stack, CRC32_JOB_STACK_SIZE);
+static struct k_thread crc_job_exec_thread;
+static struct k_spinlock m_cancel_lock;
+
+/* Recently cancelled IDs, IDs only grow so old entries never match again */
+static uint32_t m_cancel_ids[CRC32_JOB_QUEUE_LEN * 2];
+static size_t m_cancel_next;
+static atomic_t m_executor_started;
+
+static bool job_cancelled(uint32_t id)
+{
+    k_spinlock_key_t key = k_spin_lock(&m_cancel_lock);
+    bool found = false;
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_cancel_ids); i++)
+    {
+        if (m_cancel_ids[i] == id)
+        {
+            found = true;
+            break;
+        }
+    }
+
+    k_spin_unlock(&m_cancel_lock, key);
+
+    return found;
+}
+
+static bool job_request_valid(const struct crc32_job_msg *req)
+{
+    if (req->regions == 0 || req->regions > CRC32_JOB_REGIONS_MAX)
+    {
+        return false;
+    }
+
+    if (req->variant != CRC32_JOB_VARIANT_WORDS && crc32_variant_get(req->variant) == NULL)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < req->regions; i++)
+    {
+        if ((uint64_t)req->region[i].address + req->region[i].len > (uint64_t)UINT32_MAX + 1u)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static enum crc32_job_status job_run(const struct crc32_job_msg *req, uint32_t *crc)
+{
+    const struct crc32_variant *v = NULL;
+    struct crc32_ctx ctx;
+    uint32_t c = 0;
+
+    if (req->variant == CRC32_JOB_VARIANT_WORDS)
+    {
+        crc32_ctx_init(&ctx, CRC32_ORDER_REVERSE);
+    }
+    else
+    {
+        v = crc32_variant_get(req->variant);
+        c = crc32_engine_init(v);
+    }
+
+    for (size_t i = 0; i < req->regions; i++)
+    {
+        /*
+        * The reverse word order starts at the end of the last region and
+        * walks every region from its end, see crc32_segments().
+        */
+        const struct crc32_job_region *r =
+            (v == NULL) ? &req->region[req->regions - 1 - i] : &req->region[i];
+        const uint8_t *base = (const uint8_t *)(uintptr_t)r->address;
+        size_t done = 0;
+
+        while (done < r->len)
+        {
+            size_t n = MIN(r->len - done, (size_t)CRC32_JOB_CHUNK_BYTES);
+
+            if (job_cancelled(req->id))
+            {
+                return CRC32_JOB_CANCELLED;
+            }
+
+            if (v == NULL)
+            {
+                crc32_ctx_update(&ctx, &base[r->len - done - n], n);
+            }
+            else
+            {
+                c = crc32_engine_update(v, c, &base[done], n);
+            }
+
+            done += n;
+        }
+    }
+
+    *crc = (v == NULL) ? crc32_ctx_final(&ctx) : crc32_engine_final(v, c);
+
+    return CRC32_JOB_DONE;
+}
+
+static void crc_job_executor(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    struct crc32_job_msg msg;
+
+    while (1)
+    {
+        k_msgq_get(&crc_job_exec_queue, &msg, K_FOREVER);
+
+        uint32_t start = k_cycle_get_32();
+        uint32_t crc = 0;
+        enum crc32_job_status status = job_run(&msg, &crc);
+
+        msg.type = CRC32_JOB_MSG_RESULT;
+        msg.status = status;
+        msg.crc = crc;
+        msg.service_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+        if (crc32_job_transport_send(&msg) < 0)
+        {
+            LOG_ERR("Result of job %u not delivered", msg.id);
+        }
+    }
+}
+
+int crc32_job_executor_receive(const struct crc32_job_msg *msg)
+{
+    if (msg->type == CRC32_JOB_MSG_CANCEL)
+    {
+        k_spinlock_key_t key = k_spin_lock(&m_cancel_lock);
+
+        m_cancel_ids[m_cancel_next] = msg->id;
+        m_cancel_next = (m_cancel_next + 1) % ARRAY_SIZE(m_cancel_ids);
+
+        k_spin_unlock(&m_cancel_lock, key);
+        return 0;
+    }
+
+    if (msg->type != CRC32_JOB_MSG_SUBMIT || !job_request_valid(msg))
+    {
+        return -EINVAL;
+    }
+
+    if (atomic_cas(&m_executor_started, 0, 1))
+    {
+        k_thread_create(&crc_job_exec_thread, crc_job_exec_stack,
+                        K_THREAD_STACK_SIZEOF(crc_job_exec_stack),
+                        crc_job_executor, NULL, NULL, NULL,
+                        K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+        k_thread_name_set(&crc_job_exec_thread, "crc32_job");
+    }
+
+    return (k_msgq_put(&crc_job_exec_queue, msg, K_NO_WAIT) == 0) ? 0 : -EBUSY;
+}
+
+#ifndef CONFIG_CRC32_JOB_IPC
+
+/* Loopback: the executor thread above serves this core's own client */
+int crc32_job_transport_init(void)
+{
+    return 0;
+}
+
+int crc32_job_transport_send(const struct crc32_job_msg *msg)
+{
+    if (msg->type == CRC32_JOB_MSG_RESULT)
+    {
+        crc32_job_client_receive(msg);
+        return 0;
+    }
+
+    return crc32_job_executor_receive(msg);
+}
+
+#endif
+
+void crc32_job_client_receive(const struct crc32_job_msg *msg)
+{
+    struct crc32_job_result result = {0};
+    struct job_slot *slot = NULL;
+
+    k_mutex_lock(&crc_job_client_lock, K_FOREVER);
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        if (m_slots[i].used && m_slots[i].id == msg->id)
+        {
+            slot = &m_slots[i];
+            break;
+        }
+    }
+
+    if (slot == NULL)
+    {
+        k_mutex_unlock(&crc_job_client_lock);
+        LOG_WRN("Result for unknown job %u", msg->id);
+        return;
+    }
+
+    result.id = msg->id;
+    result.status = msg->status;
+    result.crc = msg->crc;
+    result.bytes = slot->bytes;
+    result.service_us = msg->service_us;
+    result.latency_us = k_cyc_to_us_floor32(k_cycle_get_32() - slot->submitted);
+
+    switch (result.status)
+    {
+        case CRC32_JOB_DONE:
+            m_stats.done++;
+            m_stats.bytes += result.bytes;
+            m_stats.service_us += result.service_us;
+            m_stats.latency_us += result.latency_us;
+            m_stats.latency_max_us = MAX(m_stats.latency_max_us, result.latency_us);
+            break;
+
+        case CRC32_JOB_CANCELLED:
+            m_stats.cancelled++;
+            break;
+
+        default:
+            m_stats.errors++;
+            break;
+    }
+
+    m_stats.pending--;
+
+    crc32_job_cb_t cb = slot->cb;
+    void *user_data = slot->user_data;
+
+    slot->used = false;
+
+    k_mutex_unlock(&crc_job_client_lock);
+
+    if (cb != NULL)
+    {
+        cb(&result, user_data);
+    }
+}
+
+int crc32_job_init(void)
+{
+    int err = 0;
+
+    k_mutex_lock(&crc_job_client_lock, K_FOREVER);
+
+    if (!m_ready)
+    {
+        err = crc32_job_transport_init();
+        m_ready = (err == 0);
+    }
+
+    k_mutex_unlock(&crc_job_client_lock);
+
+    return err;
+}
+
+int crc32_job_submit(const struct crc32_job_region *regions, size_t count, uint8_t variant,
+                     crc32_job_cb_t cb, void *user_data)
+{
+    struct crc32_job_msg msg = {
+        .type = CRC32_JOB_MSG_SUBMIT,
+        .variant = variant,
+        .regions = count,
+    };
+    struct job_slot *slot = NULL;
+    uint32_t bytes = 0;
+
+    if (regions == NULL || count == 0 || count > CRC32_JOB_REGIONS_MAX)
+    {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        msg.region[i] = regions[i];
+        bytes += regions[i].len;
+    }
+
+    if (!job_request_valid(&msg))
+    {
+        return -EINVAL;
+    }
+
+    int err = crc32_job_init();
+
+    if (err < 0)
+    {
+        return err;
+    }
+
+    k_mutex_lock(&crc_job_client_lock, K_FOREVER);
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        if (!m_slots[i].used)
+        {
+            slot = &m_slots[i];
+            break;
+        }
+    }
+
+    if (slot == NULL)
+    {
+        k_mutex_unlock(&crc_job_client_lock);
+        return -EBUSY;
+    }
+
+    msg.id = m_next_id++;
+    if (m_next_id > INT32_MAX)
+    {
+        m_next_id = 1;
+    }
+
+    *slot = (struct job_slot){
+        .id = msg.id,
+        .cb = cb,
+        .user_data = user_data,
+        .bytes = bytes,
+        .submitted = k_cycle_get_32(),
+        .used = true,
+    };
+
+    m_stats.submitted++;
+    m_stats.pending++;
+
+    k_mutex_unlock(&crc_job_client_lock);
+
+    /* The result may arrive before this returns, the slot is already set up */
+    err = crc32_job_transport_send(&msg);
+
+    if (err < 0)
+    {
+        k_mutex_lock(&crc_job_client_lock, K_FOREVER);
+        slot->used = false;
+        m_stats.submitted--;
+        m_stats.pending--;
+        k_mutex_unlock(&crc_job_client_lock);
+
+        return err;
+    }
+
+    return (int)msg.id;
+}
+
+int crc32_job_cancel(uint32_t id)
+{
+    struct crc32_job_msg msg = {
+        .type = CRC32_JOB_MSG_CANCEL,
+        .id = id,
+    };
+    bool found = false;
+
+    k_mutex_lock(&crc_job_client_lock, K_FOREVER);
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        if (m_slots[i].used && m_slots[i].id == id)
+        {
+            found = true;
+            break;
+        }
+    }
+
+    k_mutex_unlock(&crc_job_client_lock);
+
+    if (!found)
+    {
+        return -ENOENT;
+    }
+
+    return crc32_job_transport_send(&msg);
+}
+
+void crc32_job_stats_get(struct crc32_job_stats *stats)
+{
+    k_mutex_lock(&crc_job_client_lock, K_FOREVER);
+    *stats = m_stats;
+    k_mutex_unlock(&crc_job_client_lock);
+}
+
+void crc32_job_stats_reset(void)
+{
+    k_mutex_lock(&crc_job_client_lock, K_FOREVER);
+
+    uint32_t pending = m_stats.pending;
+
+    memset(&m_stats, 0, sizeof(m_stats));
+    m_stats.pending = pending;
+
+    k_mutex_unlock(&crc_job_client_lock);
+}
@@ -0,0 +1,109 @@
+#ifndef CRC32_JOB_H
+#define CRC32_JOB_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define CRC32_JOB_REGIONS_MAX  4
+#define CRC32_JOB_QUEUE_LEN    8       /* jobs in flight per client */
+#define CRC32_JOB_CHUNK_BYTES  4096    /* cancellation is checked per chunk */
+#define CRC32_JOB_STACK_SIZE   1024
+
+/*
+ * variant is an index for crc32_variant_get(), hashing the concatenated
+ * regions as one byte stream, or CRC32_JOB_VARIANT_WORDS for the bzip2
+ * reverse word order of crc32_bzip2_words() (see crc32_segments()).
+ */
+#define CRC32_JOB_VARIANT_WORDS 0xFF
+
+enum crc32_job_status
+{
+    CRC32_JOB_DONE,
+    CRC32_JOB_CANCELLED,
+    CRC32_JOB_ERROR         /* invalid request or the executor queue was full */
+};
+
+struct crc32_job_region
+{
+    uint32_t address;
+    uint32_t len;           /* bytes */
+};
+
+enum crc32_job_msg_type
+{
+    CRC32_JOB_MSG_SUBMIT = 1,
+    CRC32_JOB_MSG_CANCEL,
+    CRC32_JOB_MSG_RESULT
+};
+
+/*
+ * Request and response on the wire, same layout in both directions. Both
+ * cores are little-endian 32-bit, so the struct is sent as is.
+ */
+struct crc32_job_msg
+{
+    uint8_t type;
+    uint8_t variant;
+    uint8_t regions;
+    uint8_t status;
+    uint32_t id;
+    uint32_t crc;
+    uint32_t service_us;    /* execution time on the serving core */
+    struct crc32_job_region region[CRC32_JOB_REGIONS_MAX];
+};
+
+struct crc32_job_result
+{
+    uint32_t id;
+    enum crc32_job_status status;
+    uint32_t crc;
+    uint32_t bytes;
+    uint32_t service_us;
+    uint32_t latency_us;    /* submit to result, queueing and transport included */
+};
+
+struct crc32_job_stats
+{
+    uint32_t submitted;
+    uint32_t done;
+    uint32_t cancelled;
+    uint32_t errors;
+    uint32_t pending;
+    uint64_t bytes;         /* hashed by completed jobs */
+    uint64_t service_us;
+    uint64_t latency_us;
+    uint32_t latency_max_us;
+};
+
+/*
+ * Called once per job with its outcome, from the context that receives
+ * results: the loopback executor thread, or the IPC endpoint callback.
+ */
+typedef void (*crc32_job_cb_t)(const struct crc32_job_result *result, void *user_data);
+
+/*
+ * Open the transport. With CONFIG_CRC32_JOB_IPC the endpoint is bound on
+ * the IPC instance of the crc32-job-ipc alias; the serving core calls this
+ * too and then executes every job it receives. Without it jobs run on a
+ * local executor thread. Called by crc32_job_submit() when needed.
+ */
+int crc32_job_init(void);
+
+/*
+ * Queue a CRC over count regions. Returns the job ID (> 0), -EINVAL for a
+ * bad request or -EBUSY when CRC32_JOB_QUEUE_LEN jobs are in flight.
+ */
+int crc32_job_submit(const struct crc32_job_region *regions, size_t count, uint8_t variant,
+                     crc32_job_cb_t cb, void *user_data);
+
+/*
+ * Cancel a queued or running job; it completes with CRC32_JOB_CANCELLED
+ * unless it finished first. Returns -ENOENT for unknown IDs.
+ */
+int crc32_job_cancel(uint32_t id);
+
+void crc32_job_stats_get(struct crc32_job_stats *stats);
+
+void crc32_job_stats_reset(void);
+
+#endif // CRC32_JOB_H
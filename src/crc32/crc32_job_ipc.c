@@ -0,0 +1,105 @@
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include "crc32_job_transport.h"
+
+LOG_MODULE_REGISTER(crc32_job_ipc);
+
+#define JOB_IPC_NODE            DT_ALIAS(crc32_job_ipc)
+#define JOB_IPC_BIND_TIMEOUT_MS 1000
+
+BUILD_ASSERT(DT_NODE_HAS_STATUS(JOB_IPC_NODE, okay),
+             "CONFIG_CRC32_JOB_IPC needs a crc32-job-ipc devicetree alias");
+
+K_SEM_DEFINE(crc_job_bound, 0, 1);
+
+static struct ipc_ept m_ept;
+static bool m_registered;
+
+static void ept_bound(void *priv)
+{
+    ARG_UNUSED(priv);
+
+    k_sem_give(&crc_job_bound);
+}
+
+static void ept_received(const void *data, size_t len, void *priv)
+{
+    ARG_UNUSED(priv);
+
+    struct crc32_job_msg msg;
+
+    if (len != sizeof(msg))
+    {
+        LOG_WRN("Dropped %u byte message", (unsigned int)len);
+        return;
+    }
+
+    memcpy(&msg, data, sizeof(msg));
+
+    if (msg.type == CRC32_JOB_MSG_RESULT)
+    {
+        crc32_job_client_receive(&msg);
+        return;
+    }
+
+    /* A request the executor cannot take still gets an answer */
+    if (crc32_job_executor_receive(&msg) < 0 && msg.type == CRC32_JOB_MSG_SUBMIT)
+    {
+        msg.type = CRC32_JOB_MSG_RESULT;
+        msg.status = CRC32_JOB_ERROR;
+        msg.crc = 0;
+        msg.service_us = 0;
+        crc32_job_transport_send(&msg);
+    }
+}
+
+static const struct ipc_ept_cfg m_ept_cfg = {
+    .name = "crc32_job",
+    .cb = {
+        .bound = ept_bound,
+        .received = ept_received,
+    },
+};
+
+int crc32_job_transport_init(void)
+{
+    const struct device *ipc = DEVICE_DT_GET(JOB_IPC_NODE);
+    int err;
+
+    if (!m_registered)
+    {
+        err = ipc_service_open_instance(ipc);
+        if (err < 0 && err != -EALREADY)
+        {
+            LOG_ERR("IPC instance open failed (%d)", err);
+            return err;
+        }
+
+        err = ipc_service_register_endpoint(ipc, &m_ept, &m_ept_cfg);
+        if (err < 0)
+        {
+            LOG_ERR("Endpoint registration failed (%d)", err);
+            return err;
+        }
+
+        m_registered = true;
+    }
+
+    /* The endpoint is usable once the other core registered its side */
+    if (k_sem_take(&crc_job_bound, K_MSEC(JOB_IPC_BIND_TIMEOUT_MS)) != 0)
+    {
+        return -ETIMEDOUT;
+    }
+
+    return 0;
+}
+
+int crc32_job_transport_send(const struct crc32_job_msg *msg)
+{
+    int ret = ipc_service_send(&m_ept, msg, sizeof(*msg));
+
+    return (ret < 0) ? ret : 0;
+}
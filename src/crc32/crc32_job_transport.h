@@ -0,0 +1,21 @@
+#ifndef CRC32_JOB_TRANSPORT_H
+#define CRC32_JOB_TRANSPORT_H
+
+#include "crc32_job.h"
+
+/*
+ * Between the job client and executor in crc32_job.c and the transport:
+ * the local loopback in crc32_job.c or the IPC service in crc32_job_ipc.c.
+ */
+int crc32_job_transport_init(void);
+
+/* Deliver a message to the other side, any type */
+int crc32_job_transport_send(const struct crc32_job_msg *msg);
+
+/* Incoming submit and cancel requests */
+int crc32_job_executor_receive(const struct crc32_job_msg *msg);
+
+/* Incoming results */
+void crc32_job_client_receive(const struct crc32_job_msg *msg);
+
+#endif // CRC32_JOB_TRANSPORT_H
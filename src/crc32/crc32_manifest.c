@@ -0,0 +1,106 @@
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <string.h>
+#include "crc32_manifest.h"
+
+#define DT_DRV_COMPAT crc32_manifest
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+
+/* Regions without expected-crc are checked against their trailing CRC */
+#define MANIFEST_DT_ENTRY(node)                                             \
+    {                                                                       \
+        .address  = DT_PROP(node, address),                                 \
+        .words    = DT_PROP(node, words),                                   \
+        .expected = DT_PROP_OR(node, expected_crc, 0),                      \
+        .flags    = DT_NODE_HAS_PROP(node, expected_crc) ?                  \
+                    0 : CRC32_MANIFEST_TRAILING,                            \
+    },
+
+static const struct crc32_manifest_entry manifest_dt[] = {
+    DT_INST_FOREACH_CHILD_STATUS_OKAY(0, MANIFEST_DT_ENTRY)
+};
+
+BUILD_ASSERT(ARRAY_SIZE(manifest_dt) <= CRC32_MANIFEST_MAX,
+             "crc32-manifest has more than CRC32_MANIFEST_MAX regions");
+
+#endif
+
+const struct crc32_manifest_entry *crc32_manifest_builtin(size_t *count)
+{
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+    *count = ARRAY_SIZE(manifest_dt);
+    return manifest_dt;
+#else
+    *count = 0;
+    return NULL;
+#endif
+}
+
+int crc32_manifest_from_blob(uint32_t address, const struct crc32_manifest_entry **entries,
+                             size_t *count)
+{
+    if ((address & 0x3u) != 0)
+    {
+        return -EINVAL;
+    }
+
+    const struct crc32_manifest_blob *blob = (const struct crc32_manifest_blob *)address;
+
+    /* An empty table would verify nothing and still pass */
+    if (blob->magic != CRC32_MANIFEST_MAGIC || blob->count == 0 ||
+        blob->count > CRC32_MANIFEST_MAX)
+    {
+        return -EINVAL;
+    }
+
+    *entries = blob->entries;
+    *count = blob->count;
+
+    return 0;
+}
+
+int crc32_manifest_verify(const struct crc32_manifest_entry *entries, size_t count,
+                          struct crc32_manifest_report *report)
+{
+    if (count > CRC32_MANIFEST_MAX)
+    {
+        return -EINVAL;
+    }
+
+    memset(report, 0, sizeof(*report));
+    report->count = count;
+
+    uint32_t start = k_cycle_get_32();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const struct crc32_manifest_entry *e = &entries[i];
+        bool trailing = (e->flags & CRC32_MANIFEST_TRAILING) != 0;
+        struct crc_result r = crc32_words_check(e->address, e->words, trailing ? 1 : 0);
+        bool ok;
+
+        if (r.status == CRC_INVALID)
+        {
+            ok = false;
+        }
+        else if (trailing)
+        {
+            ok = (r.status == CRC_OK);
+        }
+        else
+        {
+            ok = (r.crc == e->expected);
+        }
+
+        if (ok)
+        {
+            report->pass[i / 32] |= 1u << (i % 32);
+            report->passed++;
+        }
+    }
+
+    report->cycles = k_cycle_get_32() - start;
+
+    return 0;
+}
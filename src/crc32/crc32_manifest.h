@@ -0,0 +1,56 @@
+#ifndef CRC32_MANIFEST_H
+#define CRC32_MANIFEST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crc32_test.h"
+
+#define CRC32_MANIFEST_MAX      64
+#define CRC32_MANIFEST_MAGIC    0x4D435243u /* "CRCM" little-endian */
+
+/* Compare with the word stored right after the region instead of expected */
+#define CRC32_MANIFEST_TRAILING 0x1u
+
+struct crc32_manifest_entry
+{
+    uint32_t address;
+    uint32_t words;
+    uint32_t expected;
+    uint32_t flags;
+};
+
+/*
+ * Layout of a manifest blob in RAM or flash: magic, entry count, then the
+ * entries, all little-endian 32-bit words.
+ */
+struct crc32_manifest_blob
+{
+    uint32_t magic;
+    uint32_t count;
+    struct crc32_manifest_entry entries[];
+};
+
+/* Bit n of pass set when entry n verified OK */
+struct crc32_manifest_report
+{
+    size_t count;
+    size_t passed;
+    uint32_t pass[CRC32_MANIFEST_MAX / 32];
+    uint32_t cycles;
+};
+
+/*
+ * Verify every entry with crc32_words_check(). Invalid entries count as
+ * failed. Returns -EINVAL for more than CRC32_MANIFEST_MAX entries.
+ */
+int crc32_manifest_verify(const struct crc32_manifest_entry *entries, size_t count,
+                          struct crc32_manifest_report *report);
+
+/* Entries of the crc32-manifest devicetree node, count 0 without one */
+const struct crc32_manifest_entry *crc32_manifest_builtin(size_t *count);
+
+/* Validate a blob at address, returns -EINVAL on a bad header or no entries */
+int crc32_manifest_from_blob(uint32_t address, const struct crc32_manifest_entry **entries,
+                             size_t *count);
+
+#endif // CRC32_MANIFEST_H
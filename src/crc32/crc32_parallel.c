@@ -0,0 +1,154 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include "crc32_parallel.h"
+#include "crc32.h"
+
+LOG_MODULE_REGISTER(crc32_parallel);
+
+struct crc_slice
+{
+    const uint32_t *data;
+    size_t words;
+    uint32_t crc;
+};
+
+struct crc_job
+{
+    struct crc_slice slice[CRC32_PARALLEL_SLICES_MAX];
+    enum crc_kernel kernel;
+    atomic_t next;
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(crc_worker_stacks, CRC32_PARALLEL_THREADS,
+                            CRC32_PARALLEL_STACK_SIZE);
+static struct k_thread crc_workers[CRC32_PARALLEL_THREADS];
+
+K_MUTEX_DEFINE(crc_job_lock);
+K_SEM_DEFINE(crc_job_sem, 0, CRC32_PARALLEL_SLICES_MAX);
+K_SEM_DEFINE(crc_done_sem, 0, CRC32_PARALLEL_SLICES_MAX);
+
+static struct crc_job m_job;
+static bool m_workers_started;
+
+static void crc_worker(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1)
+    {
+        k_sem_take(&crc_job_sem, K_FOREVER);
+
+        /* Each give on crc_job_sem hands out exactly one slice */
+        struct crc_slice *s = &m_job.slice[atomic_inc(&m_job.next)];
+
+        s->crc = crc32_bzip2_words_kernel(s->data, s->words, m_job.kernel);
+
+        k_sem_give(&crc_done_sem);
+    }
+}
+
+static void crc_workers_start(void)
+{
+    if (m_workers_started)
+    {
+        return;
+    }
+
+    for (int i = 0; i < CRC32_PARALLEL_THREADS; i++)
+    {
+        k_tid_t tid = k_thread_create(&crc_workers[i], crc_worker_stacks[i],
+                                      K_THREAD_STACK_SIZEOF(crc_worker_stacks[i]),
+                                      crc_worker, NULL, NULL, NULL,
+                                      K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+        k_thread_name_set(tid, "crc32_worker");
+    }
+
+    m_workers_started = true;
+    LOG_INF("%d CRC worker threads started", CRC32_PARALLEL_THREADS);
+}
+
+uint32_t crc32_bzip2_words_parallel(const uint32_t *data, size_t words_len,
+                                    unsigned int slices, enum crc_kernel kernel)
+{
+    if (slices > CRC32_PARALLEL_SLICES_MAX)
+    {
+        slices = CRC32_PARALLEL_SLICES_MAX;
+    }
+
+    if (slices > words_len)
+    {
+        slices = words_len;
+    }
+
+    if (slices <= 1)
+    {
+        return crc32_bzip2_words_kernel(data, words_len, kernel);
+    }
+
+    k_mutex_lock(&crc_job_lock, K_FOREVER);
+
+    crc_workers_start();
+
+    size_t per_slice = words_len / slices;
+    size_t extra = words_len % slices;
+    size_t offset = 0;
+
+    for (unsigned int i = 0; i < slices; i++)
+    {
+        size_t n = per_slice + ((i < extra) ? 1 : 0);
+
+        m_job.slice[i].data = data + offset;
+        m_job.slice[i].words = n;
+        offset += n;
+    }
+
+    m_job.kernel = kernel;
+    atomic_set(&m_job.next, 0);
+
+    for (unsigned int i = 0; i < slices; i++)
+    {
+        k_sem_give(&crc_job_sem);
+    }
+
+    for (unsigned int i = 0; i < slices; i++)
+    {
+        k_sem_take(&crc_done_sem, K_FOREVER);
+    }
+
+    /*
+    * bzip2 order walks the region backwards, so the last slice is hashed
+    * first: fold the slices from the end towards the start.
+    */
+    uint32_t crc = m_job.slice[slices - 1].crc;
+
+    for (unsigned int i = slices - 1; i > 0; i--)
+    {
+        const struct crc_slice *s = &m_job.slice[i - 1];
+
+        crc = crc32_combine(crc, s->crc, s->words * sizeof(uint32_t));
+    }
+
+    k_mutex_unlock(&crc_job_lock);
+
+    return crc;
+}
+
+struct crc_result crc32_words_check_parallel(uint32_t address, size_t words_len, int mode,
+                                             unsigned int slices, enum crc_kernel kernel)
+{
+    struct crc_result res = {0};
+
+    if (!crc32_words_valid(address, words_len)) 
+    {
+        res.status = CRC_INVALID;
+        return res;
+    }
+
+    const uint32_t *data = (const uint32_t *)address;
+    uint32_t crc = crc32_bzip2_words_parallel(data, words_len, slices, kernel);
+
+    return crc32_words_result(address, words_len, mode, crc);
+}
@@ -0,0 +1,23 @@
+#ifndef CRC32_PARALLEL_H
+#define CRC32_PARALLEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crc32_test.h"
+
+#define CRC32_PARALLEL_THREADS    4
+#define CRC32_PARALLEL_SLICES_MAX 16
+#define CRC32_PARALLEL_STACK_SIZE 1024
+
+/*
+ * Split the region into slices, CRC them on the worker pool and combine
+ * the partial results. The worker threads run at the lowest application
+ * priority so other test work keeps running while they hash.
+ */
+uint32_t crc32_bzip2_words_parallel(const uint32_t *data, size_t words_len,
+                                    unsigned int slices, enum crc_kernel kernel);
+
+struct crc_result crc32_words_check_parallel(uint32_t address, size_t words_len, int mode,
+                                             unsigned int slices, enum crc_kernel kernel);
+
+#endif // CRC32_PARALLEL_H
@@ -0,0 +1,382 @@
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/cache.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include "crc32_pipeline.h"
+#include "crc32.h"
+
+LOG_MODULE_REGISTER(crc32_pipeline);
+
+#if defined(CONFIG_DMA) && DT_NODE_HAS_STATUS(DT_ALIAS(crc32_dma), okay)
+#define PIPELINE_DMA_NODE DT_ALIAS(crc32_dma)
+#endif
+
+struct copy_job
+{
+    void *dst;
+    const void *src;
+    size_t bytes;
+    int status;                 /* DMA result, the caller copies on failure */
+};
+
+K_THREAD_STACK_DEFINE(crc_copy_stack, CRC32_PIPELINE_STACK_SIZE);
+static struct k_thread crc_copy_thread;
+
+K_MUTEX_DEFINE(crc_pipeline_lock);
+K_SEM_DEFINE(crc_copy_job_sem, 0, CRC32_PIPELINE_BUFFERS_MAX);
+static struct k_sem crc_copy_done_sem[CRC32_PIPELINE_BUFFERS_MAX];
+
+/*
+ * Written by the DMA controller and read by the CPU. Kept cacheable so the
+ * kernel reads it at cache speed; the cache is maintained around each
+ * transfer, so the pool must not share cache lines with other data.
+ */
+static uint32_t m_pool[CRC32_PIPELINE_POOL_WORDS] __aligned(CRC32_PIPELINE_POOL_ALIGN);
+static struct copy_job m_jobs[CRC32_PIPELINE_BUFFERS_MAX];
+static unsigned int m_buffers;
+static unsigned int m_job_next;
+static uint32_t m_copy_cycles;
+static bool m_copy_started;
+
+/* Jobs complete in buffer order, one per buffer at a time */
+static void job_done(unsigned int buf)
+{
+    m_job_next = (buf + 1) % m_buffers;
+    k_sem_give(&crc_copy_done_sem[buf]);
+}
+
+#ifdef PIPELINE_DMA_NODE
+static const struct device *const m_dma = DEVICE_DT_GET(PIPELINE_DMA_NODE);
+static int m_dma_channel = -1;
+
+/* Guards the DMA queue against dma_done(), which runs in the DMA ISR */
+static struct k_spinlock m_dma_lock;
+static unsigned int m_dma_queued;   /* submitted, not yet started */
+static bool m_dma_busy;
+static uint32_t m_dma_started;
+
+static void dma_done(const struct device *dev, void *user_data, uint32_t channel, int status);
+
+/*
+ * Starts the oldest queued job if the channel is idle. Called with
+ * m_dma_lock held, from copy_submit() on the caller's thread and from
+ * dma_done() to chain the next transfer without a thread switch.
+ */
+static void dma_start_next(void)
+{
+    while (!m_dma_busy && m_dma_queued > 0)
+    {
+        unsigned int next = m_job_next;
+        struct copy_job *job = &m_jobs[next];
+        struct dma_block_config blk = {
+            .source_address = (uintptr_t)job->src,
+            .dest_address = (uintptr_t)job->dst,
+            .block_size = job->bytes,
+        };
+        struct dma_config cfg = {
+            .channel_direction = MEMORY_TO_MEMORY,
+            .source_data_size = sizeof(uint32_t),
+            .dest_data_size = sizeof(uint32_t),
+            .source_burst_length = sizeof(uint32_t),
+            .dest_burst_length = sizeof(uint32_t),
+            .block_count = 1,
+            .head_block = &blk,
+            .dma_callback = dma_done,
+        };
+
+        /* The controller reads memory, not the cache */
+        sys_cache_data_flush_range((void *)job->src, job->bytes);
+
+        int ret = dma_config(m_dma, m_dma_channel, &cfg);
+
+        if (ret == 0)
+        {
+            ret = dma_start(m_dma, m_dma_channel);
+        }
+
+        m_dma_queued--;
+
+        if (ret == 0)
+        {
+            m_dma_busy = true;
+            m_dma_started = k_cycle_get_32();
+            return;
+        }
+
+        /* Hand the buffer back, the caller copies it with the CPU */
+        job->status = ret;
+        job_done(next);
+    }
+}
+
+static void dma_done(const struct device *dev, void *user_data, uint32_t channel, int status)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(user_data);
+    ARG_UNUSED(channel);
+
+    k_spinlock_key_t key = k_spin_lock(&m_dma_lock);
+    unsigned int next = m_job_next;
+    struct copy_job *job = &m_jobs[next];
+
+    m_copy_cycles += k_cycle_get_32() - m_dma_started;
+    m_dma_busy = false;
+
+    /* Drop lines fetched while the transfer ran so the CRC reads the new data */
+    sys_cache_data_invd_range(job->dst, job->bytes);
+    job->status = status;
+    job_done(next);
+
+    dma_start_next();
+
+    k_spin_unlock(&m_dma_lock, key);
+}
+#endif
+
+static bool copy_uses_dma(void)
+{
+#ifdef PIPELINE_DMA_NODE
+    return m_dma_channel >= 0;
+#else
+    return false;
+#endif
+}
+
+/* Only runs without a DMA channel */
+static void crc_copier(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1)
+    {
+        k_sem_take(&crc_copy_job_sem, K_FOREVER);
+
+        unsigned int next = m_job_next;
+        const struct copy_job *job = &m_jobs[next];
+        uint32_t start = k_cycle_get_32();
+
+        memcpy(job->dst, job->src, job->bytes);
+
+        m_copy_cycles += k_cycle_get_32() - start;
+
+        job_done(next);
+    }
+}
+
+static void copy_engine_start(void)
+{
+    if (m_copy_started)
+    {
+        return;
+    }
+
+    for (int i = 0; i < CRC32_PIPELINE_BUFFERS_MAX; i++)
+    {
+        k_sem_init(&crc_copy_done_sem[i], 0, 1);
+    }
+
+    m_copy_started = true;
+
+#ifdef PIPELINE_DMA_NODE
+    if (device_is_ready(m_dma))
+    {
+        m_dma_channel = dma_request_channel(m_dma, NULL);
+    }
+
+    if (copy_uses_dma())
+    {
+        return;
+    }
+
+    LOG_WRN("no DMA channel, using the memcpy worker");
+#endif
+
+    k_tid_t tid = k_thread_create(&crc_copy_thread, crc_copy_stack,
+                                  K_THREAD_STACK_SIZEOF(crc_copy_stack),
+                                  crc_copier, NULL, NULL, NULL,
+                                  K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+    k_thread_name_set(tid, "crc32_copy");
+}
+
+static void copy_submit(unsigned int buf, const uint32_t *src, size_t words)
+{
+    m_jobs[buf].dst = &m_pool[buf * CRC32_PIPELINE_BUFFER_WORDS(m_buffers)];
+    m_jobs[buf].src = src;
+    m_jobs[buf].bytes = words * sizeof(uint32_t);
+    m_jobs[buf].status = 0;
+
+#ifdef PIPELINE_DMA_NODE
+    /*
+    * Start the transfer right here if the channel is idle, so a caller
+    * above the worker priority still overlaps it with the kernel.
+    */
+    if (copy_uses_dma())
+    {
+        k_spinlock_key_t key = k_spin_lock(&m_dma_lock);
+
+        m_dma_queued++;
+        dma_start_next();
+
+        k_spin_unlock(&m_dma_lock, key);
+        return;
+    }
+#endif
+
+    k_sem_give(&crc_copy_job_sem);
+}
+
+/* Waits for a buffer; a failed DMA transfer is redone with the CPU */
+static void copy_wait(unsigned int buf)
+{
+    k_sem_take(&crc_copy_done_sem[buf], K_FOREVER);
+
+#ifdef PIPELINE_DMA_NODE
+    struct copy_job *job = &m_jobs[buf];
+
+    if (job->status == 0)
+    {
+        return;
+    }
+
+    LOG_ERR("DMA copy failed (%d), copying with the CPU", job->status);
+
+    uint32_t start = k_cycle_get_32();
+
+    memcpy(job->dst, job->src, job->bytes);
+
+    /* No dirty lines in the pool, a later invalidate would drop them */
+    sys_cache_data_flush_range(job->dst, job->bytes);
+
+    k_spinlock_key_t key = k_spin_lock(&m_dma_lock);
+
+    m_copy_cycles += k_cycle_get_32() - start;
+
+    k_spin_unlock(&m_dma_lock, key);
+#endif
+}
+
+int crc32_bzip2_words_pipeline(const uint32_t *data, size_t words_len,
+                               const struct crc32_pipeline_cfg *cfg, uint32_t *crc,
+                               struct crc32_pipeline_stats *stats)
+{
+    static const struct crc32_pipeline_cfg defaults = {
+        .chunk_words = CRC32_PIPELINE_CHUNK_WORDS_DEFAULT,
+        .buffers = CRC32_PIPELINE_BUFFERS_DEFAULT,
+    };
+    struct crc32_pipeline_stats st = {0};
+
+    if (cfg == NULL)
+    {
+        cfg = &defaults;
+    }
+
+    if (cfg->buffers < 2 || cfg->buffers > CRC32_PIPELINE_BUFFERS_MAX ||
+        cfg->chunk_words == 0 || words_len == 0 ||
+        cfg->chunk_words > CRC32_PIPELINE_BUFFER_WORDS(cfg->buffers))
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&crc_pipeline_lock, K_FOREVER);
+
+    copy_engine_start();
+    /* The copy engine is idle here, every job of the last run was consumed */
+    m_buffers = cfg->buffers;
+    m_job_next = 0;
+    m_copy_cycles = 0;
+
+    size_t chunks = DIV_ROUND_UP(words_len, cfg->chunk_words);
+    uint32_t c;
+    uint32_t start = k_cycle_get_32();
+
+    BZ2_initialise_crc(&c);
+
+    /*
+    * bzip2 order hashes the top of the region first, so chunk i covers the
+    * words just below chunk i - 1. Chunk 0 may be the short one; every
+    * other chunk is full.
+    */
+    size_t first = words_len - (chunks - 1) * cfg->chunk_words;
+    size_t hi = words_len;
+
+    for (size_t i = 0; i < MIN(chunks, (size_t)cfg->buffers); i++)
+    {
+        size_t n = (i == 0) ? first : cfg->chunk_words;
+
+        copy_submit(i, &data[hi - n], n);
+        hi -= n;
+    }
+
+    for (size_t i = 0; i < chunks; i++)
+    {
+        unsigned int buf = i % cfg->buffers;
+        size_t n = (i == 0) ? first : cfg->chunk_words;
+        uint32_t t0 = k_cycle_get_32();
+
+        copy_wait(buf);
+
+        uint32_t t1 = k_cycle_get_32();
+
+        BZ2_update_crc_words_rev(&c, m_jobs[buf].dst, n);
+
+        st.wait_cycles += t1 - t0;
+        st.crc_cycles += k_cycle_get_32() - t1;
+
+        /* Refill this buffer with the chunk cfg->buffers further down */
+        if (i + cfg->buffers < chunks)
+        {
+            copy_submit(buf, &data[hi - cfg->chunk_words], cfg->chunk_words);
+            hi -= cfg->chunk_words;
+        }
+    }
+
+    BZ2_finalise_crc(&c);
+    *crc = c;
+
+    st.total_cycles = k_cycle_get_32() - start;
+    st.copy_cycles = m_copy_cycles;
+    st.chunks = chunks;
+    st.dma = copy_uses_dma();
+
+    k_mutex_unlock(&crc_pipeline_lock);
+
+    /*
+    * Without overlap the run takes crc + copy cycles; whatever is missing
+    * from the total ran in parallel.
+    */
+    uint32_t serial = st.crc_cycles + st.copy_cycles;
+
+    if (st.copy_cycles != 0 && serial > st.total_cycles)
+    {
+        st.overlap_percent = MIN(100u, (uint32_t)(((uint64_t)(serial - st.total_cycles) * 100) /
+                                                  st.copy_cycles));
+    }
+
+    if (stats != NULL)
+    {
+        *stats = st;
+    }
+
+    return 0;
+}
+
+struct crc_result crc32_words_check_pipeline(uint32_t address, size_t words_len, int mode,
+                                             const struct crc32_pipeline_cfg *cfg,
+                                             struct crc32_pipeline_stats *stats)
+{
+    struct crc_result res = {0};
+    uint32_t crc;
+
+    if (!crc32_words_valid(address, words_len) ||
+        crc32_bzip2_words_pipeline((const uint32_t *)address, words_len, cfg, &crc, stats) < 0)
+    {
+        res.status = CRC_INVALID;
+        return res;
+    }
+
+    return crc32_words_result(address, words_len, mode, crc);
+}
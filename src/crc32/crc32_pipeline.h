@@ -0,0 +1,57 @@
+#ifndef CRC32_PIPELINE_H
+#define CRC32_PIPELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <zephyr/sys/util.h>
+#include "crc32_test.h"
+
+#define CRC32_PIPELINE_POOL_WORDS          2048   /* 8 KiB of bounce buffers */
+#define CRC32_PIPELINE_BUFFERS_MAX         4
+#define CRC32_PIPELINE_CHUNK_WORDS_DEFAULT 512
+#define CRC32_PIPELINE_BUFFERS_DEFAULT     2
+#define CRC32_PIPELINE_STACK_SIZE          1024
+#define CRC32_PIPELINE_POOL_ALIGN          32     /* data cache line */
+
+/*
+ * Each buffer gets an equal share of the pool, rounded down to whole cache
+ * lines so that cache maintenance on one buffer never touches another.
+ */
+#define CRC32_PIPELINE_BUFFER_WORDS(buffers) \
+    ROUND_DOWN(CRC32_PIPELINE_POOL_WORDS / (buffers), CRC32_PIPELINE_POOL_ALIGN / sizeof(uint32_t))
+
+/* chunk_words must fit in CRC32_PIPELINE_BUFFER_WORDS(buffers) */
+struct crc32_pipeline_cfg
+{
+    size_t chunk_words;
+    unsigned int buffers;
+};
+
+struct crc32_pipeline_stats
+{
+    bool dma;                   /* copies done by DMA, else the memcpy worker */
+    size_t chunks;
+    uint32_t total_cycles;
+    uint32_t crc_cycles;        /* kernel time */
+    uint32_t copy_cycles;       /* copy engine busy time */
+    uint32_t wait_cycles;       /* kernel waiting for a chunk */
+    unsigned int overlap_percent; /* share of the copy time hidden behind the kernel */
+};
+
+/*
+ * bzip2 CRC of a region in slow memory. Chunks are copied into RAM bounce
+ * buffers by DMA (devicetree alias crc32-dma), started from the caller and
+ * chained from the completion callback, or by a memcpy worker thread
+ * while the kernel works on the previous chunk. cfg NULL uses the
+ * defaults, stats may be NULL. Returns -EINVAL for a bad configuration.
+ */
+int crc32_bzip2_words_pipeline(const uint32_t *data, size_t words_len,
+                               const struct crc32_pipeline_cfg *cfg, uint32_t *crc,
+                               struct crc32_pipeline_stats *stats);
+
+struct crc_result crc32_words_check_pipeline(uint32_t address, size_t words_len, int mode,
+                                             const struct crc32_pipeline_cfg *cfg,
+                                             struct crc32_pipeline_stats *stats);
+
+#endif // CRC32_PIPELINE_H
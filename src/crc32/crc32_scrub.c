@@ -0,0 +1,317 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include "crc32_scrub.h"
+#include "crc32_test.h"
+#include "crc32.h"
+
+LOG_MODULE_REGISTER(crc32_scrub);
+
+K_THREAD_STACK_DEFINE(crc_scrub_stack, CRC32_SCRUB_STACK_SIZE);
+static struct k_thread crc_scrub_thread;
+
+K_MUTEX_DEFINE(crc_scrub_lock);
+K_SEM_DEFINE(crc_scrub_wake, 0, 1);
+
+static struct crc32_scrub_region m_regions[CRC32_SCRUB_REGIONS_MAX];
+static size_t m_region_count;
+static crc32_scrub_cb_t m_callback;
+
+static unsigned int m_duty_percent = CRC32_SCRUB_DUTY_DEFAULT;
+static uint32_t m_period_ms = CRC32_SCRUB_PERIOD_MS_DEFAULT;
+
+/* Walk position: region, words still to hash below it, running register */
+static size_t m_current;
+static size_t m_remaining;
+static uint32_t m_crc;
+
+static uint32_t m_passes;
+static uint32_t m_mismatches;
+static uint64_t m_busy_cycles;
+static int64_t m_started_ms;
+static atomic_t m_running;
+static bool m_thread_started;
+
+static void scrub_restart_region(void)
+{
+    m_remaining = m_regions[m_current].words;
+    BZ2_initialise_crc(&m_crc);
+}
+
+/*
+ * Hash one chunk of the current region. Returns true and fills *done with a
+ * copy of the region when it was completed and did not match.
+ */
+static bool scrub_chunk(struct crc32_scrub_region *done, uint32_t *crc, bool *pass_end,
+                        uint32_t *busy)
+{
+    struct crc32_scrub_region *r = &m_regions[m_current];
+    const uint32_t *data = (const uint32_t *)r->address;
+    size_t n = MIN(m_remaining, (size_t)CRC32_SCRUB_CHUNK_WORDS);
+    bool mismatch = false;
+
+    /* bzip2 order: chunks from the top of the region downwards */
+    uint32_t start = k_cycle_get_32();
+
+    BZ2_update_crc_words_rev(&m_crc, &data[m_remaining - n], n);
+
+    *busy = k_cycle_get_32() - start;
+    m_remaining -= n;
+
+    if (m_remaining != 0)
+    {
+        return false;
+    }
+
+    BZ2_finalise_crc(&m_crc);
+    r->last_crc = m_crc;
+    r->checks++;
+
+    if (m_crc != r->golden)
+    {
+        r->failures++;
+        m_mismatches++;
+        *done = *r;
+        *crc = m_crc;
+        mismatch = true;
+    }
+
+    m_current++;
+    if (m_current == m_region_count)
+    {
+        m_current = 0;
+        m_passes++;
+        *pass_end = true;
+    }
+
+    scrub_restart_region();
+
+    return mismatch;
+}
+
+static void crc_scrubber(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    uint64_t idle_owed = 0;
+
+    while (1)
+    {
+        if (!atomic_get(&m_running))
+        {
+            k_sem_take(&crc_scrub_wake, K_FOREVER);
+            continue;
+        }
+
+        struct crc32_scrub_region done;
+        uint32_t crc = 0;
+        uint32_t busy = 0;
+        bool pass_end = false;
+        bool mismatch = false;
+
+        k_mutex_lock(&crc_scrub_lock, K_FOREVER);
+
+        if (m_region_count == 0)
+        {
+            pass_end = true;
+        }
+        else
+        {
+            mismatch = scrub_chunk(&done, &crc, &pass_end, &busy);
+            m_busy_cycles += busy;
+        }
+
+        crc32_scrub_cb_t cb = m_callback;
+        unsigned int duty = m_duty_percent;
+        uint32_t period_ms = m_period_ms;
+
+        k_mutex_unlock(&crc_scrub_lock);
+
+        if (mismatch)
+        {
+            LOG_WRN("region 0x%08X: CRC 0x%08X, expected 0x%08X",
+                    done.address, crc, done.golden);
+
+            if (cb != NULL)
+            {
+                cb(&done, crc);
+            }
+        }
+
+        /*
+        * Stay below the duty cycle: a chunk that took busy cycles owes
+        * busy * (100 - duty) / duty cycles of sleep. Sleeps shorter than a
+        * tick would round up, so the debt is collected and only yielded
+        * until it reaches CRC32_SCRUB_SLEEP_MIN_US. Stop and a start of a
+        * stopped scrubber give the semaphore, so they cut a sleep short.
+        */
+        idle_owed += ((uint64_t)busy * (100 - duty)) / duty;
+
+        uint64_t idle_us = k_cyc_to_us_floor64(idle_owed);
+
+        if (pass_end)
+        {
+            idle_owed = 0;
+            k_sem_take(&crc_scrub_wake, K_MSEC(period_ms + idle_us / 1000));
+        }
+        else if (idle_us >= CRC32_SCRUB_SLEEP_MIN_US)
+        {
+            idle_owed = 0;
+            k_sem_take(&crc_scrub_wake, K_USEC(idle_us));
+        }
+        else
+        {
+            k_yield();
+        }
+    }
+}
+
+int crc32_scrub_add(uint32_t address, size_t words_len, uint32_t golden)
+{
+    int index;
+
+    if (!crc32_words_valid(address, words_len))
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&crc_scrub_lock, K_FOREVER);
+
+    if (m_region_count == CRC32_SCRUB_REGIONS_MAX)
+    {
+        k_mutex_unlock(&crc_scrub_lock);
+        return -ENOMEM;
+    }
+
+    index = (int)m_region_count;
+    m_regions[index] = (struct crc32_scrub_region) {
+        .address = address,
+        .words = words_len,
+        .golden = golden,
+    };
+    m_region_count++;
+
+    /* First region: the walk starts here */
+    if (index == 0)
+    {
+        m_current = 0;
+        scrub_restart_region();
+    }
+
+    k_mutex_unlock(&crc_scrub_lock);
+
+    return index;
+}
+
+void crc32_scrub_clear(void)
+{
+    k_mutex_lock(&crc_scrub_lock, K_FOREVER);
+
+    m_region_count = 0;
+    m_current = 0;
+    m_remaining = 0;
+
+    k_mutex_unlock(&crc_scrub_lock);
+}
+
+void crc32_scrub_set_callback(crc32_scrub_cb_t cb)
+{
+    k_mutex_lock(&crc_scrub_lock, K_FOREVER);
+    m_callback = cb;
+    k_mutex_unlock(&crc_scrub_lock);
+}
+
+int crc32_scrub_set_budget(unsigned int duty_percent, uint32_t period_ms)
+{
+    if (duty_percent == 0 || duty_percent > 100)
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&crc_scrub_lock, K_FOREVER);
+    m_duty_percent = duty_percent;
+    m_period_ms = period_ms;
+    k_mutex_unlock(&crc_scrub_lock);
+
+    return 0;
+}
+
+void crc32_scrub_start(void)
+{
+    bool started = false;
+
+    k_mutex_lock(&crc_scrub_lock, K_FOREVER);
+
+    if (!m_thread_started)
+    {
+        k_tid_t tid = k_thread_create(&crc_scrub_thread, crc_scrub_stack,
+                                      K_THREAD_STACK_SIZEOF(crc_scrub_stack),
+                                      crc_scrubber, NULL, NULL, NULL,
+                                      K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+        k_thread_name_set(tid, "crc32_scrub");
+        m_thread_started = true;
+    }
+
+    if (!atomic_get(&m_running))
+    {
+        m_busy_cycles = 0;
+        m_started_ms = k_uptime_get();
+        atomic_set(&m_running, 1);
+        started = true;
+    }
+
+    k_mutex_unlock(&crc_scrub_lock);
+
+    /* Waking a running scrubber would cut its budget sleep short */
+    if (started)
+    {
+        k_sem_give(&crc_scrub_wake);
+        LOG_INF("scrubber started, %u%% duty", m_duty_percent);
+    }
+}
+
+void crc32_scrub_stop(void)
+{
+    atomic_set(&m_running, 0);
+    k_sem_give(&crc_scrub_wake);
+}
+
+void crc32_scrub_status_get(struct crc32_scrub_status *status)
+{
+    k_mutex_lock(&crc_scrub_lock, K_FOREVER);
+
+    int64_t elapsed_ms = k_uptime_get() - m_started_ms;
+
+    status->running = atomic_get(&m_running) != 0;
+    status->regions = m_region_count;
+    status->duty_percent = m_duty_percent;
+    status->period_ms = m_period_ms;
+    status->passes = m_passes;
+    status->mismatches = m_mismatches;
+    status->busy_permille = (elapsed_ms > 0) ?
+        (uint32_t)(k_cyc_to_us_floor64(m_busy_cycles) / (uint64_t)elapsed_ms) : 0;
+
+    k_mutex_unlock(&crc_scrub_lock);
+}
+
+int crc32_scrub_region_get(size_t index, struct crc32_scrub_region *region)
+{
+    int ret = 0;
+
+    k_mutex_lock(&crc_scrub_lock, K_FOREVER);
+
+    if (index < m_region_count)
+    {
+        *region = m_regions[index];
+    }
+    else
+    {
+        ret = -EINVAL;
+    }
+
+    k_mutex_unlock(&crc_scrub_lock);
+
+    return ret;
+}
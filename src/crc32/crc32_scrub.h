@@ -0,0 +1,69 @@
+#ifndef CRC32_SCRUB_H
+#define CRC32_SCRUB_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define CRC32_SCRUB_REGIONS_MAX       8
+#define CRC32_SCRUB_CHUNK_WORDS       256     /* 1 KiB per time slice */
+#define CRC32_SCRUB_DUTY_DEFAULT      2       /* percent of one CPU */
+#define CRC32_SCRUB_PERIOD_MS_DEFAULT 10000   /* pause between passes */
+#define CRC32_SCRUB_SLEEP_MIN_US      1000    /* shorter idle time is batched */
+#define CRC32_SCRUB_STACK_SIZE        1024
+
+struct crc32_scrub_region
+{
+    uint32_t address;
+    size_t words;
+    uint32_t golden;
+    uint32_t last_crc;
+    uint32_t checks;
+    uint32_t failures;
+};
+
+struct crc32_scrub_status
+{
+    bool running;
+    size_t regions;
+    unsigned int duty_percent;
+    uint32_t period_ms;
+    uint32_t passes;
+    uint32_t mismatches;
+    uint32_t busy_permille;     /* measured CPU share since start */
+};
+
+/* Called from the scrubber thread for every region whose CRC differs */
+typedef void (*crc32_scrub_cb_t)(const struct crc32_scrub_region *region, uint32_t crc);
+
+/*
+ * Add a region with its golden bzip2 CRC. Returns the region index,
+ * -EINVAL for an invalid region or -ENOMEM when the table is full.
+ */
+int crc32_scrub_add(uint32_t address, size_t words_len, uint32_t golden);
+
+/* Drop all regions and restart the walk */
+void crc32_scrub_clear(void);
+
+void crc32_scrub_set_callback(crc32_scrub_cb_t cb);
+
+/*
+ * duty_percent bounds the CPU time of the scrubber: after every chunk it
+ * sleeps long enough to stay below it. period_ms is the pause after each
+ * full pass over all regions.
+ */
+int crc32_scrub_set_budget(unsigned int duty_percent, uint32_t period_ms);
+
+/*
+ * Start or stop the low priority scrubber thread, created on first start.
+ * Starting a running scrubber does nothing.
+ */
+void crc32_scrub_start(void);
+void crc32_scrub_stop(void);
+
+void crc32_scrub_status_get(struct crc32_scrub_status *status);
+
+/* Copy of region index, returns -EINVAL past the last region */
+int crc32_scrub_region_get(size_t index, struct crc32_scrub_region *region);
+
+#endif // CRC32_SCRUB_H
@@ -0,0 +1,140 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <errno.h>
+#include "crc32_stream.h"
+#include "crc32.h"
+#include "crc32_tier.h"
+#include "crc32_clmul.h"
+
+/* Reverse mode reads aligned words in place of descending byte runs */
+BUILD_ASSERT(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+             "crc32 reverse stream order requires a little-endian target");
+
+static void update_forward(uint32_t *crc, const uint8_t *p, size_t len)
+{
+    uint32_t c = *crc;
+
+    /* Unaligned head bytes */
+    while (len > 0 && ((uintptr_t)p & 0x3u) != 0)
+    {
+        c = crc32_msb_byte(crc32_bzip2_table, c, *p++);
+        len--;
+    }
+
+    /*
+    * Aligned body, two words per step. Byte order in memory is the stream
+    * order, so each word is loaded big-endian to put its first byte on top.
+    */
+    const uint32_t *w = (const uint32_t *)p;
+
+    while (len >= 2 * sizeof(uint32_t))
+    {
+        c = crc32_msb_word2(crc32_bzip2_table, c,
+                            sys_be32_to_cpu(w[0]), sys_be32_to_cpu(w[1]));
+        w += 2;
+        len -= 2 * sizeof(uint32_t);
+    }
+
+    p = (const uint8_t *)w;
+
+    while (len > 0)
+    {
+        c = crc32_msb_byte(crc32_bzip2_table, c, *p++);
+        len--;
+    }
+
+    *crc = c;
+}
+
+static void update_reverse(uint32_t *crc, const uint8_t *p, size_t len)
+{
+    const uint8_t *end = p + len;
+
+    /* Unaligned tail bytes, highest address first */
+    while (end > p && ((uintptr_t)end & 0x3u) != 0)
+    {
+        BZ2_update_crc(crc, *--end);
+    }
+
+    /* Aligned body through the word kernel */
+    size_t words = (size_t)(end - p) / sizeof(uint32_t);
+
+    end -= words * sizeof(uint32_t);
+    if (!crc32_clmul_update_words_rev(crc, (const uint32_t *)end, words))
+    {
+        BZ2_update_crc_words_rev(crc, (const uint32_t *)end, words);
+    }
+
+    /* Remaining head bytes */
+    while (end > p)
+    {
+        BZ2_update_crc(crc, *--end);
+    }
+}
+
+void crc32_ctx_init(struct crc32_ctx *ctx, enum crc32_order order)
+{
+    BZ2_initialise_crc(&ctx->crc);
+    ctx->order = order;
+}
+
+void crc32_ctx_update(struct crc32_ctx *ctx, const void *data, size_t len)
+{
+    if (data == NULL || len == 0)
+    {
+        return;
+    }
+
+    if (ctx->order == CRC32_ORDER_REVERSE)
+    {
+        update_reverse(&ctx->crc, data, len);
+    }
+    else
+    {
+        update_forward(&ctx->crc, data, len);
+    }
+}
+
+uint32_t crc32_ctx_final(struct crc32_ctx *ctx)
+{
+    uint32_t crc = ctx->crc;
+
+    BZ2_finalise_crc(&crc);
+    return crc;
+}
+
+int crc32_segments(const struct crc32_segment *segs, size_t count,
+                   enum crc32_order order, uint32_t *crc)
+{
+    struct crc32_ctx ctx;
+
+    if ((segs == NULL && count != 0) || crc == NULL)
+    {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((uint64_t)segs[i].address + segs[i].len > (uint64_t)UINT32_MAX + 1u)
+        {
+            return -EINVAL;
+        }
+    }
+
+    crc32_ctx_init(&ctx, order);
+
+    /*
+    * Reverse order starts at the end of the concatenation, so the last
+    * segment goes first; each one is then walked from its own end.
+    */
+    for (size_t i = 0; i < count; i++)
+    {
+        const struct crc32_segment *seg =
+            (order == CRC32_ORDER_REVERSE) ? &segs[count - 1 - i] : &segs[i];
+
+        crc32_ctx_update(&ctx, (const void *)(uintptr_t)seg->address, seg->len);
+    }
+
+    *crc = crc32_ctx_final(&ctx);
+    return 0;
+}
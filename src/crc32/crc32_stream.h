@@ -0,0 +1,51 @@
+#ifndef CRC32_STREAM_H
+#define CRC32_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Byte order in which chunks are fed to the CRC */
+enum crc32_order
+{
+    /* Chunks in stream order, bytes from the chunk start (plain CRC-32/BZIP2) */
+    CRC32_ORDER_FORWARD,
+    /*
+     * Chunks from the end of the region to its start, bytes from the chunk
+     * end. On little-endian targets this is the crc32_bzip2_words() order:
+     * words last to first, each word MSB-first.
+     */
+    CRC32_ORDER_REVERSE
+};
+
+struct crc32_ctx
+{
+    uint32_t crc;
+    enum crc32_order order;
+};
+
+void crc32_ctx_init(struct crc32_ctx *ctx, enum crc32_order order);
+
+/* Feed a chunk of any size and alignment */
+void crc32_ctx_update(struct crc32_ctx *ctx, const void *data, size_t len);
+
+/* Returns the CRC of everything fed so far, the context can be re-initialised */
+uint32_t crc32_ctx_final(struct crc32_ctx *ctx);
+
+/* One piece of a non-contiguous region, e.g. header, app slot and trailer */
+struct crc32_segment
+{
+    uint32_t address;
+    size_t len;         /* bytes, any alignment */
+};
+
+/*
+ * CRC over the concatenation of segs[0] .. segs[count - 1], read in place.
+ * CRC32_ORDER_FORWARD hashes it as one byte stream, CRC32_ORDER_REVERSE
+ * gives the crc32_bzip2_words() result the concatenation would have if it
+ * were contiguous. Returns -EINVAL for a NULL table or a segment that wraps
+ * the address space.
+ */
+int crc32_segments(const struct crc32_segment *segs, size_t count,
+                   enum crc32_order order, uint32_t *crc);
+
+#endif // CRC32_STREAM_H
@@ -0,0 +1,278 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crc32_syndrome.h"
+#include "crc32.h"
+
+/* Order of the multiplicative group of GF(2^32), generated by x */
+#define GROUP_ORDER   0xFFFFFFFFu
+/* x, and x^32 mod P: a flip in the last bit of the stream */
+#define POLY_X        0x00000002u
+/* Baby steps for the 65537 subgroup, 256 * 257 covers it */
+#define BSGS_STEPS    256
+#define BSGS_SUBGROUP 65537u
+
+/* 2^32 - 1 = 3 * 5 * 17 * 257 * 65537 */
+static const uint32_t m_factors[] = { 3, 5, 17, 257, BSGS_SUBGROUP };
+
+struct baby_step
+{
+    uint32_t value;
+    uint32_t exponent;
+};
+
+K_MUTEX_DEFINE(crc_syndrome_lock);
+
+static bool m_ready;
+static struct baby_step m_baby[BSGS_STEPS];
+static uint32_t m_giant;
+static uint32_t m_pair_log[CRC32_SYNDROME_DOUBLE_SPAN + 1];
+
+static uint32_t gf_pow(uint32_t a, uint32_t e)
+{
+    uint32_t r = 1;
+
+    while (e != 0)
+    {
+        if (e & 1u)
+        {
+            r = crc32_multmodp(r, a);
+        }
+
+        a = crc32_multmodp(a, a);
+        e >>= 1;
+    }
+
+    return r;
+}
+
+static uint32_t mod_pow(uint64_t a, uint32_t e, uint32_t q)
+{
+    uint64_t r = 1;
+
+    a %= q;
+    while (e != 0)
+    {
+        if (e & 1u)
+        {
+            r = (r * a) % q;
+        }
+
+        a = (a * a) % q;
+        e >>= 1;
+    }
+
+    return (uint32_t)r;
+}
+
+static int baby_cmp(const void *a, const void *b)
+{
+    uint32_t va = ((const struct baby_step *)a)->value;
+    uint32_t vb = ((const struct baby_step *)b)->value;
+
+    return (va > vb) - (va < vb);
+}
+
+/* Logarithm of h to base g in the subgroup of order q */
+static uint32_t subgroup_log(uint32_t g, uint32_t h, uint32_t q)
+{
+    if (q != BSGS_SUBGROUP)
+    {
+        uint32_t t = 1;
+
+        for (uint32_t j = 0; j < q; j++)
+        {
+            if (t == h)
+            {
+                return j;
+            }
+
+            t = crc32_multmodp(t, g);
+        }
+
+        return 0;
+    }
+
+    /* Baby-step giant-step, h * g^(-256 i) against the sorted g^j table */
+    for (uint32_t i = 0; i <= BSGS_SUBGROUP / BSGS_STEPS; i++)
+    {
+        struct baby_step key = { .value = h };
+        const struct baby_step *hit = bsearch(&key, m_baby, BSGS_STEPS,
+                                              sizeof(m_baby[0]), baby_cmp);
+
+        if (hit != NULL)
+        {
+            return (i * BSGS_STEPS + hit->exponent) % q;
+        }
+
+        h = crc32_multmodp(h, m_giant);
+    }
+
+    return 0;
+}
+
+/* e with x^e = v mod P, v must be non-zero */
+static uint32_t discrete_log(uint32_t v)
+{
+    uint64_t e = 0;
+
+    /* Pohlig-Hellman: the log modulo each factor, joined by the CRT */
+    for (size_t i = 0; i < ARRAY_SIZE(m_factors); i++)
+    {
+        uint32_t q = m_factors[i];
+        uint32_t m = GROUP_ORDER / q;
+        uint32_t r = subgroup_log(gf_pow(POLY_X, m), gf_pow(v, m), q);
+        uint64_t inv = mod_pow(m, q - 2, q);
+
+        e = (e + (uint64_t)m * ((r * inv) % q)) % GROUP_ORDER;
+    }
+
+    return (uint32_t)e;
+}
+
+static void syndrome_init(void)
+{
+    k_mutex_lock(&crc_syndrome_lock, K_FOREVER);
+
+    if (!m_ready)
+    {
+        uint32_t g = gf_pow(POLY_X, GROUP_ORDER / BSGS_SUBGROUP);
+        uint32_t t = 1;
+
+        for (uint32_t j = 0; j < BSGS_STEPS; j++)
+        {
+            m_baby[j].value = t;
+            m_baby[j].exponent = j;
+            t = crc32_multmodp(t, g);
+        }
+
+        qsort(m_baby, BSGS_STEPS, sizeof(m_baby[0]), baby_cmp);
+        m_giant = gf_pow(g, BSGS_SUBGROUP - BSGS_STEPS);
+
+        for (uint32_t d = 1; d <= CRC32_SYNDROME_DOUBLE_SPAN; d++)
+        {
+            m_pair_log[d] = discrete_log(1u ^ gf_pow(POLY_X, d));
+        }
+
+        m_ready = true;
+    }
+
+    k_mutex_unlock(&crc_syndrome_lock);
+}
+
+/* Stream position k counts the bits after the flip, see crc32_syndrome.h */
+static void set_position(struct crc32_error_location *loc, int n, uint32_t address,
+                         uint64_t k)
+{
+    loc->address[n] = address + (uint32_t)(k / 32) * sizeof(uint32_t);
+    loc->bit[n] = (uint8_t)(k % 32);
+}
+
+void crc32_syndrome_locate(uint32_t address, size_t words_len, uint32_t syndrome,
+                           struct crc32_error_location *loc)
+{
+    uint64_t bits = (uint64_t)words_len * 32;
+
+    memset(loc, 0, sizeof(*loc));
+
+    if (syndrome == 0)
+    {
+        loc->kind = CRC32_ERROR_NONE;
+        return;
+    }
+
+    /* A flip in the region never leaves a single syndrome bit */
+    if ((syndrome & (syndrome - 1)) == 0)
+    {
+        loc->kind = CRC32_ERROR_TRAILER;
+        loc->address[0] = address + words_len * sizeof(uint32_t);
+        loc->bit[0] = (uint8_t)(find_lsb_set(syndrome) - 1);
+        return;
+    }
+
+    syndrome_init();
+
+    uint32_t e = discrete_log(syndrome);
+    uint64_t k = ((uint64_t)e + GROUP_ORDER - 32) % GROUP_ORDER;
+
+    if (k < bits)
+    {
+        loc->kind = CRC32_ERROR_SINGLE;
+        set_position(loc, 0, address, k);
+        return;
+    }
+
+    /*
+    * Two flips d bits apart give x^(32 + a) * (1 + x^d). Only a single
+    * fitting d is reported, several would be indistinguishable.
+    */
+    int matches = 0;
+
+    loc->kind = CRC32_ERROR_UNKNOWN;
+
+    for (uint32_t d = 1; d <= CRC32_SYNDROME_DOUBLE_SPAN; d++)
+    {
+        uint64_t a = ((uint64_t)e + 2ull * GROUP_ORDER - m_pair_log[d] - 32) % GROUP_ORDER;
+
+        if (a + d < bits)
+        {
+            set_position(loc, 0, address, a);
+            set_position(loc, 1, address, a + d);
+            matches++;
+        }
+    }
+
+    if (matches == 1)
+    {
+        loc->kind = CRC32_ERROR_DOUBLE;
+    }
+    else
+    {
+        memset(loc->address, 0, sizeof(loc->address));
+        memset(loc->bit, 0, sizeof(loc->bit));
+    }
+}
+
+struct crc_result crc32_words_check_locate(uint32_t address, size_t words_len, bool repair,
+                                           struct crc32_error_location *loc)
+{
+    struct crc_result res = {0};
+
+    memset(loc, 0, sizeof(*loc));
+
+    if (!crc32_words_valid(address, words_len))
+    {
+        res.status = CRC_INVALID;
+        return res;
+    }
+
+    res = crc32_words_check(address, words_len, 1);
+
+    if (res.status != CRC_FAIL)
+    {
+        return res;
+    }
+
+    /* res.crc is the stored CRC, crc_ref the computed one */
+    crc32_syndrome_locate(address, words_len, res.crc ^ res.crc_ref, loc);
+
+    if (!repair || loc->kind == CRC32_ERROR_UNKNOWN)
+    {
+        return res;
+    }
+
+    int flips = (loc->kind == CRC32_ERROR_DOUBLE) ? 2 : 1;
+
+    for (int i = 0; i < flips; i++)
+    {
+        volatile uint32_t *word = (volatile uint32_t *)(uintptr_t)loc->address[i];
+
+        *word ^= BIT(loc->bit[i]);
+    }
+
+    res = crc32_words_check(address, words_len, 1);
+    loc->repaired = (res.status == CRC_OK);
+
+    return res;
+}
@@ -0,0 +1,52 @@
+#ifndef CRC32_SYNDROME_H
+#define CRC32_SYNDROME_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "crc32_test.h"
+
+/* Largest distance in bits between the two flips of a double-bit error */
+#define CRC32_SYNDROME_DOUBLE_SPAN 64
+
+/* What the syndrome of a failed check decodes to */
+enum crc32_error_kind
+{
+    CRC32_ERROR_NONE,       /* stored and computed CRC agree */
+    CRC32_ERROR_TRAILER,    /* one bit of the stored CRC word flipped */
+    CRC32_ERROR_SINGLE,     /* one bit in the region */
+    CRC32_ERROR_DOUBLE,     /* two bits at most CRC32_SYNDROME_DOUBLE_SPAN apart */
+    CRC32_ERROR_UNKNOWN     /* more bits flipped, or no unique double-bit match */
+};
+
+struct crc32_error_location
+{
+    enum crc32_error_kind kind;
+    /* Word address and bit (0 = LSB) of each flip, [1] for double-bit only */
+    uint32_t address[2];
+    uint8_t bit[2];
+    bool repaired;
+};
+
+/*
+ * Decode syndrome = stored CRC ^ computed CRC for the crc32_bzip2_words()
+ * region at address/words_len. A flip k bits before the end of the word
+ * stream changes the CRC by x^(32 + k) mod P, and the bzip2 polynomial is
+ * primitive, so k is the discrete logarithm of the syndrome. It is taken
+ * by Pohlig-Hellman over the factors of 2^32 - 1 with small lookup tables,
+ * independent of the region size. Double-bit errors are matched against
+ * the logarithms of 1 + x^d for d up to CRC32_SYNDROME_DOUBLE_SPAN.
+ */
+void crc32_syndrome_locate(uint32_t address, size_t words_len, uint32_t syndrome,
+                           struct crc32_error_location *loc);
+
+/*
+ * crc32_words_check() mode 1 that also locates the error on CRC_FAIL.
+ * With repair set, located flips are written back in place, the stored CRC
+ * included, and the region is checked again; status is then CRC_OK when
+ * the repair held. Only use repair on RAM regions.
+ */
+struct crc_result crc32_words_check_locate(uint32_t address, size_t words_len, bool repair,
+                                           struct crc32_error_location *loc);
+
+#endif // CRC32_SYNDROME_H
@@ -0,0 +1,68 @@
+# CRC32 variants for the parametric engine: name:poly:reflected:init:xorout
+set(CRC32_VARIANTS
+    bzip2:0x04C11DB7:0:0xFFFFFFFF:0xFFFFFFFF
+)
+
+# Only generated with CONFIG_CRC32_ENGINE_VARIANTS
+set(CRC32_EXTRA_VARIANTS
+    iso_hdlc:0x04C11DB7:1:0xFFFFFFFF:0xFFFFFFFF
+    c:0x1EDC6F41:1:0xFFFFFFFF:0xFFFFFFFF
+    mpeg2:0x04C11DB7:0:0xFFFFFFFF:0x00000000
+)
+
+# Variants that also get x^-1 tables with CONFIG_CRC32_FORWARD_KERNEL; only
+# the bzip2 forward kernel uses them
+set(CRC32_INV_TABLE_VARIANTS bzip2)
+
+set(CRC32_GEN_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/../../scripts/gen_crc_tables.py)
+
+# Generate the lookup tables at build time and add them to <target>
+function(crc32_generate_tables target)
+    set(gen_dir ${CMAKE_CURRENT_BINARY_DIR}/crc32_gen)
+    set(gen_files ${gen_dir}/crc32_tables_gen.c ${gen_dir}/crc32_tables_gen.h)
+    set(variant_args)
+    set(variants ${CRC32_VARIANTS})
+
+    # Table layout follows the CONFIG_CRC32_IMPL_* tier, see Kconfig
+    if(CONFIG_CRC32_IMPL_NIBBLE)
+        set(tier_args --entries 16 --slices 1)
+    elseif(CONFIG_CRC32_IMPL_TABLE)
+        set(tier_args --entries 256 --slices 1)
+    else()
+        set(tier_args --entries 256 --slices 8)
+    endif()
+
+    if(CONFIG_CRC32_ENGINE_VARIANTS)
+        list(APPEND variants ${CRC32_EXTRA_VARIANTS})
+    endif()
+
+    foreach(variant ${variants})
+        list(APPEND variant_args --variant ${variant})
+    endforeach()
+
+    if(CONFIG_CRC32_FORWARD_KERNEL)
+        foreach(variant ${CRC32_INV_TABLE_VARIANTS})
+            list(APPEND variant_args --inv-table ${variant})
+        endforeach()
+    endif()
+
+    # Only rewritten when the arguments change, so a new tier or variant list
+    # regenerates the tables even with generators that ignore the command line
+    set(gen_stamp ${gen_dir}/crc32_tables_gen.args)
+    string(REPLACE ";" " " gen_args "${tier_args} ${variant_args}")
+    file(CONFIGURE OUTPUT ${gen_stamp} CONTENT "${gen_args}\n")
+
+    add_custom_command(
+        OUTPUT ${gen_files}
+        COMMAND ${PYTHON_EXECUTABLE} ${CRC32_GEN_SCRIPT}
+                --output-dir ${gen_dir} ${tier_args} ${variant_args}
+        DEPENDS ${CRC32_GEN_SCRIPT} ${gen_stamp}
+        COMMENT "Generating CRC32 lookup tables"
+    )
+
+    add_custom_target(crc32_tables_gen DEPENDS ${gen_files})
+    add_dependencies(${target} crc32_tables_gen)
+
+    target_sources(${target} PRIVATE ${gen_dir}/crc32_tables_gen.c)
+    target_include_directories(${target} PRIVATE ${gen_dir})
+endfunction()
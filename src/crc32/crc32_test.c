@@ -1,86 +1,288 @@
-#include <zephyr/kernel.h>
-#include <zephyr/logging/log.h>
-#include "crc32_test.h"
-#include "crc32.h"
-
-LOG_MODULE_REGISTER(crc32_test);
-
-uint32_t crc32_bzip2_words(const uint32_t *data, size_t words_len)
-{
-    uint32_t crc;
-    BZ2_initialise_crc(&crc);
-
-    /*
-    * Input order matches bzip2 CRC32 implementation:
-    * words are processed in reverse order and bytes MSB-first.
-    */
-    for (size_t w = words_len; w > 0; w--) 
-    {
-        uint32_t v = data[w - 1];
-
-        uint8_t b0 = (v >> 24) & 0xFF;
-        uint8_t b1 = (v >> 16) & 0xFF;
-        uint8_t b2 = (v >> 8)  & 0xFF;
-        uint8_t b3 =  v        & 0xFF;
-
-        BZ2_update_crc(&crc, b0);
-        BZ2_update_crc(&crc, b1);
-        BZ2_update_crc(&crc, b2);
-        BZ2_update_crc(&crc, b3);
-    }
-
-    BZ2_finalise_crc(&crc);
-    return crc;
-}
-
-struct crc_result crc32_words_check(uint32_t address, size_t words_len, int mode)
-{
-    struct crc_result res = {0};
-
-    if ((address & 0x3u) != 0) 
-    {
-        res.status = CRC_INVALID;
-        return res;
-    }
-
-    if (words_len == 0) 
-    {
-        res.status = CRC_INVALID;
-        return res;
-    }
-
-    const uint32_t *data = (const uint32_t *)address;
-    uint32_t crc = crc32_bzip2_words(data, words_len);
-
-    res.crc = crc;
-
-    if (mode == 0) 
-    {
-        res.status = CRC_UNUSED;
-        return res;
-    }
-
-    if (mode == 1) 
-    {
-        uintptr_t crc_addr = address + words_len * sizeof(uint32_t);
-        uint32_t stored_crc = *(uint32_t *)crc_addr;
-
-        if (stored_crc == crc) 
-        { 
-            res.status = CRC_OK; 
-        } 
-        else 
-        { 
-            res.status = CRC_FAIL; 
-        }
-        
-        res.crc = stored_crc; 
-        res.crc_ref = crc;
-        
-        return res;
-    }
-
-    res.status = CRC_INVALID;
-
-    return res;
-}
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+#include "crc32_test.h"
+#include "crc32.h"
+#include "crc32_clmul.h"
+
+LOG_MODULE_REGISTER(crc32_test);
+
+static const char *const kernel_names[CRC_KERNEL_COUNT] = {
+    [CRC_KERNEL_BYTE]   = "byte",
+    [CRC_KERNEL_SLICE8] = "slice8",
+    [CRC_KERNEL_FORWARD] = "forward",
+    [CRC_KERNEL_CLMUL]  = "clmul",
+};
+
+static void crc32_update_words_bytewise(uint32_t *crc, const uint32_t *data, size_t words_len)
+{
+    /*
+    * Input order matches bzip2 CRC32 implementation:
+    * words are processed in reverse order and bytes MSB-first.
+    */
+    for (size_t w = words_len; w > 0; w--) 
+    {
+        uint32_t v = data[w - 1];
+
+        uint8_t b0 = (v >> 24) & 0xFF;
+        uint8_t b1 = (v >> 16) & 0xFF;
+        uint8_t b2 = (v >> 8)  & 0xFF;
+        uint8_t b3 =  v        & 0xFF;
+
+        BZ2_update_crc(crc, b0);
+        BZ2_update_crc(crc, b1);
+        BZ2_update_crc(crc, b2);
+        BZ2_update_crc(crc, b3);
+    }
+}
+
+#ifdef CONFIG_CRC32_FORWARD_KERNEL
+static void crc32_update_words_forward(uint32_t *crc, const uint32_t *data, size_t words_len)
+{
+    uint32_t acc = 0;
+
+    /*
+    * Read data[0] upwards so every cache line is filled in address order,
+    * then shift the accumulated value into the reverse-order CRC.
+    */
+    BZ2_update_crc_words_fwd(&acc, data, words_len);
+    BZ2_update_crc_fwd_finish(crc, acc, words_len);
+}
+#endif
+
+void crc32_update_words_kernel(uint32_t *crc, const uint32_t *data, size_t words_len,
+                               enum crc_kernel kernel)
+{
+    switch (kernel)
+    {
+        case CRC_KERNEL_BYTE:
+            crc32_update_words_bytewise(crc, data, words_len);
+            break;
+
+#ifdef CONFIG_CRC32_FORWARD_KERNEL
+        case CRC_KERNEL_FORWARD:
+            crc32_update_words_forward(crc, data, words_len);
+            break;
+#endif
+
+        case CRC_KERNEL_CLMUL:
+            /* Falls back to the table kernel without PCLMULQDQ or for short regions */
+            if (!crc32_clmul_update_words_rev(crc, data, words_len))
+            {
+                BZ2_update_crc_words_rev(crc, data, words_len);
+            }
+            break;
+
+        case CRC_KERNEL_SLICE8:
+        default:
+            /* Two words per table step, also forward without its x^-1 tables */
+            BZ2_update_crc_words_rev(crc, data, words_len);
+            break;
+    }
+}
+
+uint32_t crc32_bzip2_words_kernel(const uint32_t *data, size_t words_len,
+                                  enum crc_kernel kernel)
+{
+    uint32_t crc;
+    BZ2_initialise_crc(&crc);
+
+    crc32_update_words_kernel(&crc, data, words_len, kernel);
+
+    BZ2_finalise_crc(&crc);
+    return crc;
+}
+
+uint32_t crc32_bzip2_bytes_kernel(const uint8_t *data, size_t len, enum crc_kernel kernel)
+{
+    const uint8_t *end = data + len;
+    uint32_t crc;
+    BZ2_initialise_crc(&crc);
+
+    /*
+    * Same order as the word kernels, highest address first. The unaligned
+    * tail and head bytes go through the byte step, the aligned body in
+    * between through the selected word kernel.
+    */
+    while (end > data && ((uintptr_t)end & 0x3u) != 0)
+    {
+        BZ2_update_crc(&crc, *--end);
+    }
+
+    size_t words = (size_t)(end - data) / sizeof(uint32_t);
+
+    end -= words * sizeof(uint32_t);
+    crc32_update_words_kernel(&crc, (const uint32_t *)end, words, kernel);
+
+    while (end > data)
+    {
+        BZ2_update_crc(&crc, *--end);
+    }
+
+    BZ2_finalise_crc(&crc);
+    return crc;
+}
+
+uint32_t crc32_bzip2_words(const uint32_t *data, size_t words_len)
+{
+    return crc32_bzip2_words_kernel(data, words_len, CRC_KERNEL_DEFAULT);
+}
+
+bool crc32_kernel_built(enum crc_kernel kernel)
+{
+    /* The switch above runs slice8 for kernels left out of the build */
+    if (kernel == CRC_KERNEL_FORWARD)
+    {
+        return IS_ENABLED(CONFIG_CRC32_FORWARD_KERNEL);
+    }
+
+    return kernel < CRC_KERNEL_COUNT;
+}
+
+int crc32_kernel_from_name(const char *name, enum crc_kernel *kernel)
+{
+    for (int k = 0; k < CRC_KERNEL_COUNT; k++)
+    {
+        if (strcmp(name, kernel_names[k]) == 0)
+        {
+            if (!crc32_kernel_built((enum crc_kernel)k))
+            {
+                return -ENOTSUP;
+            }
+
+            *kernel = (enum crc_kernel)k;
+            return 0;
+        }
+    }
+
+    return -EINVAL;
+}
+
+const char *crc32_tier_name(void)
+{
+#if defined(CONFIG_CRC32_IMPL_NIBBLE)
+    return "nibble";
+#elif defined(CONFIG_CRC32_IMPL_TABLE)
+    return "table";
+#else
+    return "slicing";
+#endif
+}
+
+const char *crc32_kernel_name(enum crc_kernel kernel)
+{
+    if (kernel >= CRC_KERNEL_COUNT)
+    {
+        return "unknown";
+    }
+
+    return kernel_names[kernel];
+}
+
+struct crc_result crc32_words_check(uint32_t address, size_t words_len, int mode)
+{
+    return crc32_words_check_kernel(address, words_len, mode, CRC_KERNEL_DEFAULT);
+}
+
+bool crc32_words_valid(uint32_t address, size_t words_len)
+{
+    if ((address & 0x3u) != 0) 
+    {
+        return false;
+    }
+
+    if (words_len == 0) 
+    {
+        return false;
+    }
+
+    return true;
+}
+
+struct crc_result crc32_words_result(uint32_t address, size_t words_len, int mode,
+                                     uint32_t crc)
+{
+    struct crc_result res = {0};
+
+    res.crc = crc;
+
+    if (mode == 0) 
+    {
+        res.status = CRC_UNUSED;
+        return res;
+    }
+
+    if (mode == 1) 
+    {
+        uintptr_t crc_addr = address + words_len * sizeof(uint32_t);
+        uint32_t stored_crc = *(uint32_t *)crc_addr;
+
+        if (stored_crc == crc) 
+        { 
+            res.status = CRC_OK; 
+        } 
+        else 
+        { 
+            res.status = CRC_FAIL; 
+        }
+        
+        res.crc = stored_crc; 
+        res.crc_ref = crc;
+        
+        return res;
+    }
+
+    res.status = CRC_INVALID;
+
+    return res;
+}
+
+struct crc_result crc32_bytes_check(uint32_t address, size_t len, int mode)
+{
+    return crc32_bytes_check_kernel(address, len, mode, CRC_KERNEL_DEFAULT);
+}
+
+struct crc_result crc32_bytes_check_kernel(uint32_t address, size_t len, int mode,
+                                           enum crc_kernel kernel)
+{
+    struct crc_result res = {0};
+
+    if (len == 0 || (mode != 0 && mode != 1))
+    {
+        res.status = CRC_INVALID;
+        return res;
+    }
+
+    res.crc = crc32_bzip2_bytes_kernel((const uint8_t *)address, len, kernel);
+
+    if (mode == 0)
+    {
+        res.status = CRC_UNUSED;
+        return res;
+    }
+
+    /* The trailer follows the region directly and may be unaligned */
+    res.crc_ref = res.crc;
+    res.crc = sys_get_le32((const uint8_t *)(address + len));
+    res.status = (res.crc == res.crc_ref) ? CRC_OK : CRC_FAIL;
+
+    return res;
+}
+
+struct crc_result crc32_words_check_kernel(uint32_t address, size_t words_len, int mode,
+                                           enum crc_kernel kernel)
+{
+    struct crc_result res = {0};
+
+    if (!crc32_words_valid(address, words_len)) 
+    {
+        res.status = CRC_INVALID;
+        return res;
+    }
+
+    const uint32_t *data = (const uint32_t *)address;
+    uint32_t crc = crc32_bzip2_words_kernel(data, words_len, kernel);
+
+    return crc32_words_result(address, words_len, mode, crc);
+}
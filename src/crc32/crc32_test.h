@@ -1,25 +1,99 @@
-#ifndef CRC32_TEST_H
-#define CRC32_TEST_H
-
-#include <stdint.h>
-
-enum crc_status 
-{
-    CRC_OK,
-    CRC_FAIL,
-    CRC_INVALID,
-    CRC_UNUSED
-};
-
-struct crc_result 
-{
-    uint32_t crc;
-    uint32_t crc_ref;
-    enum crc_status status;
-};
-
-uint32_t crc32_bzip2_words(const uint32_t *data, size_t words_len);
-
-struct crc_result crc32_words_check(uint32_t address, size_t words_len, int mode);
-
-#endif // CRC32_TEST_H
+#ifndef CRC32_TEST_H
+#define CRC32_TEST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+enum crc_status 
+{
+    CRC_OK,
+    CRC_FAIL,
+    CRC_INVALID,
+    CRC_UNUSED
+};
+
+/* CRC kernel used to process the word stream */
+enum crc_kernel
+{
+    CRC_KERNEL_BYTE,    /* bzip2 reference, one table lookup per byte */
+    CRC_KERNEL_SLICE8,  /* slicing-by-8, two words per step */
+    CRC_KERNEL_FORWARD, /* slicing-by-8 reading the region front-to-back */
+    CRC_KERNEL_CLMUL,   /* PCLMULQDQ folding on x86 hosts, else slice8 */
+    CRC_KERNEL_COUNT
+};
+
+#ifdef CONFIG_CRC32_CLMUL
+#define CRC_KERNEL_DEFAULT CRC_KERNEL_CLMUL
+#else
+#define CRC_KERNEL_DEFAULT CRC_KERNEL_SLICE8
+#endif
+
+struct crc_result 
+{
+    uint32_t crc;
+    uint32_t crc_ref;
+    enum crc_status status;
+};
+
+uint32_t crc32_bzip2_words(const uint32_t *data, size_t words_len);
+
+uint32_t crc32_bzip2_words_kernel(const uint32_t *data, size_t words_len,
+                                  enum crc_kernel kernel);
+
+/* Continue register *crc over data[words_len - 1] .. data[0] with a kernel */
+void crc32_update_words_kernel(uint32_t *crc, const uint32_t *data, size_t words_len,
+                               enum crc_kernel kernel);
+
+/*
+ * Byte-granular form of crc32_bzip2_words_kernel(): bytes from the end of
+ * the region to its start, so for whole aligned words both agree. data and
+ * len may have any alignment.
+ */
+uint32_t crc32_bzip2_bytes_kernel(const uint8_t *data, size_t len, enum crc_kernel kernel);
+
+struct crc_result crc32_words_check(uint32_t address, size_t words_len, int mode);
+
+struct crc_result crc32_words_check_kernel(uint32_t address, size_t words_len, int mode,
+                                           enum crc_kernel kernel);
+
+/*
+ * Byte-addressed crc32_words_check(): any address and length in bytes. In
+ * mode 1 the reference CRC is the little-endian word right after the last
+ * byte, which need not be aligned.
+ */
+struct crc_result crc32_bytes_check(uint32_t address, size_t len, int mode);
+
+struct crc_result crc32_bytes_check_kernel(uint32_t address, size_t len, int mode,
+                                           enum crc_kernel kernel);
+
+/* Alignment and length checks shared by the crc32_words_check variants */
+bool crc32_words_valid(uint32_t address, size_t words_len);
+
+/*
+ * Build the result for a CRC computed over address/words_len.
+ * mode 0 returns the CRC, mode 1 compares it with the word stored
+ * right after the region.
+ */
+struct crc_result crc32_words_result(uint32_t address, size_t words_len, int mode,
+                                     uint32_t crc);
+
+/* False for kernels whose option is off; those run the slice8 kernel */
+bool crc32_kernel_built(enum crc_kernel kernel);
+
+/*
+ * Kernel name lookup for the shell, returns -EINVAL for unknown names and
+ * -ENOTSUP for kernels left out of the build
+ */
+int crc32_kernel_from_name(const char *name, enum crc_kernel *kernel);
+
+const char *crc32_kernel_name(enum crc_kernel kernel);
+
+/*
+ * CONFIG_CRC32_IMPL_* tier of the tables. Only the slicing tier makes the
+ * slice8 and forward kernels slicing-by-8; the smaller tiers run them one
+ * table lookup per byte, or two for nibble.
+ */
+const char *crc32_tier_name(void);
+
+#endif // CRC32_TEST_H
@@ -0,0 +1,100 @@
+#ifndef CRC32_TIER_H
+#define CRC32_TIER_H
+
+#include <stdint.h>
+#include "crc32_tables_gen.h"
+
+/*
+ * Table lookup steps for the CONFIG_CRC32_IMPL_* tier. The generated
+ * tables hold CRC32_TABLE_ENTRIES entries (16 for the nibble tier, 256
+ * otherwise) and CRC32_TABLE_SLICES slices (8 for the slicing tier).
+ * The msb helpers serve MSB-first registers, the lsb helpers reflected
+ * ones and the x^-1 forward tables.
+ */
+typedef uint32_t crc32_table_t[CRC32_TABLE_ENTRIES];
+
+static inline uint32_t crc32_msb_byte(const crc32_table_t *t, uint32_t c, uint8_t b)
+{
+#if CRC32_TABLE_ENTRIES == 16
+    c = (c << 4) ^ t[0][(c >> 28) ^ (b >> 4)];
+    return (c << 4) ^ t[0][(c >> 28) ^ (b & 0xF)];
+#else
+    return (c << 8) ^ t[0][(c >> 24) ^ b];
+#endif
+}
+
+static inline uint32_t crc32_lsb_byte(const crc32_table_t *t, uint32_t c, uint8_t b)
+{
+#if CRC32_TABLE_ENTRIES == 16
+    c ^= b;
+    c = (c >> 4) ^ t[0][c & 0xF];
+    return (c >> 4) ^ t[0][c & 0xF];
+#else
+    return (c >> 8) ^ t[0][(c ^ b) & 0xFF];
+#endif
+}
+
+/* One word, most significant byte first */
+static inline uint32_t crc32_msb_word(const crc32_table_t *t, uint32_t c, uint32_t w)
+{
+#if CRC32_TABLE_SLICES >= 4
+    uint32_t x = c ^ w;
+
+    return t[3][x >> 24] ^ t[2][(x >> 16) & 0xFF] ^
+           t[1][(x >> 8) & 0xFF] ^ t[0][x & 0xFF];
+#else
+    c = crc32_msb_byte(t, c, w >> 24);
+    c = crc32_msb_byte(t, c, (w >> 16) & 0xFF);
+    c = crc32_msb_byte(t, c, (w >> 8) & 0xFF);
+    return crc32_msb_byte(t, c, w & 0xFF);
+#endif
+}
+
+/* One word, least significant byte first */
+static inline uint32_t crc32_lsb_word(const crc32_table_t *t, uint32_t c, uint32_t w)
+{
+#if CRC32_TABLE_SLICES >= 4
+    uint32_t x = c ^ w;
+
+    return t[3][x & 0xFF] ^ t[2][(x >> 8) & 0xFF] ^
+           t[1][(x >> 16) & 0xFF] ^ t[0][x >> 24];
+#else
+    c = crc32_lsb_byte(t, c, w & 0xFF);
+    c = crc32_lsb_byte(t, c, (w >> 8) & 0xFF);
+    c = crc32_lsb_byte(t, c, (w >> 16) & 0xFF);
+    return crc32_lsb_byte(t, c, w >> 24);
+#endif
+}
+
+/* Two words, w1 first: slicing-by-8 when the tables are there */
+static inline uint32_t crc32_msb_word2(const crc32_table_t *t, uint32_t c,
+                                       uint32_t w1, uint32_t w2)
+{
+#if CRC32_TABLE_SLICES >= 8
+    uint32_t x = c ^ w1;
+
+    return t[7][x >> 24] ^ t[6][(x >> 16) & 0xFF] ^
+           t[5][(x >> 8) & 0xFF] ^ t[4][x & 0xFF] ^
+           t[3][w2 >> 24] ^ t[2][(w2 >> 16) & 0xFF] ^
+           t[1][(w2 >> 8) & 0xFF] ^ t[0][w2 & 0xFF];
+#else
+    return crc32_msb_word(t, crc32_msb_word(t, c, w1), w2);
+#endif
+}
+
+static inline uint32_t crc32_lsb_word2(const crc32_table_t *t, uint32_t c,
+                                       uint32_t w1, uint32_t w2)
+{
+#if CRC32_TABLE_SLICES >= 8
+    uint32_t x = c ^ w1;
+
+    return t[7][x & 0xFF] ^ t[6][(x >> 8) & 0xFF] ^
+           t[5][(x >> 16) & 0xFF] ^ t[4][x >> 24] ^
+           t[3][w2 & 0xFF] ^ t[2][(w2 >> 8) & 0xFF] ^
+           t[1][(w2 >> 16) & 0xFF] ^ t[0][w2 >> 24];
+#else
+    return crc32_lsb_word(t, crc32_lsb_word(t, c, w1), w2);
+#endif
+}
+
+#endif // CRC32_TIER_H
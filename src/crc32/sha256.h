@@ -0,0 +1,25 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SHA256_DIGEST_SIZE 32
+#define SHA256_BLOCK_SIZE  64
+
+/* FIPS 180-4 SHA-256, incremental */
+struct sha256_ctx
+{
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t block[SHA256_BLOCK_SIZE];
+    size_t fill;
+};
+
+void sha256_init(struct sha256_ctx *ctx);
+
+void sha256_update(struct sha256_ctx *ctx, const void *data, size_t len);
+
+void sha256_final(struct sha256_ctx *ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+#endif // SHA256_H
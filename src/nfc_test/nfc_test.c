@@ -1,469 +1,1353 @@
-#include <zephyr/kernel.h>
-#include <nfc/ndef/msg.h>
-#include <nfc/ndef/text_rec.h>
-#include <nfc/t4t/ndef_file.h>
-#include <nfc_t4t_lib.h>
-#include <nfc/ndef/msg_parser.h>
-#include <zephyr/logging/log.h>
-#include "nfc_test.h"
-
-LOG_MODULE_REGISTER(nfctest);
-
-K_MUTEX_DEFINE(nfc_lock);
-K_CONDVAR_DEFINE(nfc_read_cv);
-K_CONDVAR_DEFINE(nfc_write_cv);
-
-static bool m_ndef_operation_done;
-static bool m_field_off;
-
-static uint8_t m_ndef_msg_buf[NDEF_MSG_BUF_SIZE];
-static uint32_t m_ndef_len = NDEF_MSG_BUF_SIZE;
-
-static bool m_nfc_t4t_initialized;
-
-uint32_t timeout_ms = NFCTEST_RW_TIMEOUT_DEFAULT_MS;
-
-typedef enum
-{
-    NDEF_OP_NONE,
-    NDEF_TEST_READ,
-    NDEF_TEST_WRITE
-} ndef_op;
-
-static ndef_op m_current_op = NDEF_OP_NONE;
-
-/* Parse a TEXT NDEF record written by an NFC reader/writer (e.g. a smartphone) and extract its payload */
-static int handle_ndef_text_record(const uint8_t *data, size_t data_length, uint8_t *payload_buf,
-                                         size_t *payload_len)
-{
-    int err;
-
-    if (!data || data_length <= 2)
-    {
-        LOG_WRN("NDEF data too short");
-        return -EINVAL;
-    }
-
-    /* Skip NLEN (2 bytes) */
-    const uint8_t *ndef_msg_buf = data + 2;
-    uint32_t ndef_msg_len = data_length - 2;
-
-    struct nfc_ndef_bin_payload_desc bin_payload;
-    struct nfc_ndef_record_desc record;
-    enum nfc_ndef_record_location record_location;
-
-    /* Parse first NDEF record */
-    err = nfc_ndef_record_parse(&bin_payload,
-                                &record,
-                                &record_location,
-                                ndef_msg_buf,
-                                &ndef_msg_len);
-    if (err)
-    {
-        LOG_ERR("NDEF record parse failed (%d)", err);
-        return err;
-    }
-
-    /* Verify TEXT record */
-    if (record.tnf != TNF_WELL_KNOWN ||
-        record.type_length != 1 ||
-        record.type[0] != 'T')
-    {
-        LOG_WRN("Not a TEXT record");
-        return -ENOTSUP;
-    }
-
-    /* Validate payload */
-    if (bin_payload.payload_length < 1)
-    {
-        LOG_ERR("Invalid TEXT payload length");
-        return -EINVAL;
-    }
-
-    const uint8_t *payload = bin_payload.payload;
-    uint32_t payload_length = bin_payload.payload_length;
-
-    uint8_t status = payload[0];
-    uint8_t lang_len = status & 0x3F;
-
-    if (payload_length < (1 + lang_len))
-    {
-        LOG_ERR("Invalid language code length");
-        return -EINVAL;
-    }
-
-    const uint8_t *text = &payload[1 + lang_len];
-    uint32_t text_len = payload_length - 1 - lang_len;
-
-    uint32_t copy_len = MIN(text_len, NFCTEST_PAYLOAD_MAX - 1);
-
-    memcpy(payload_buf, text, copy_len);
-    payload_buf[copy_len] = '\0';
-    *payload_len = copy_len;
-
-    LOG_INF("NFC RX TEXT: %s", payload_buf);
-
-    return 0;
-}
-
-/*
- * NFC Type 4 Tag event callback.
- * Called by the NFC library whenever a field is detected, removed,
- * or an NDEF message is read/written by a phone.
- */
-static void nfc_t4t_callback(void *context,
-                    nfc_t4t_event_t event,
-                    const uint8_t *data,
-                    size_t data_length,
-                    uint32_t flags)
-{
-    ARG_UNUSED(context);
-    ARG_UNUSED(flags);
-
-    k_mutex_lock(&nfc_lock, K_FOREVER);
-
-    switch (event) 
-    {
-        case NFC_T4T_EVENT_FIELD_ON:
-            LOG_INF("NFC field detected: phone is near");
-            break;
-
-        case NFC_T4T_EVENT_FIELD_OFF:
-            LOG_INF("NFC field lost: phone moved away");
-            if (m_ndef_operation_done)
-            {
-                m_field_off = true;
-            }
-            
-            k_condvar_signal(&nfc_read_cv);
-            k_condvar_signal(&nfc_write_cv);
-            break;
-
-        case NFC_T4T_EVENT_NDEF_READ:
-            LOG_INF("NDEF message read, length: %zu", data_length);
-
-
-            if (m_current_op == NDEF_TEST_READ)
-            {
-                m_ndef_operation_done = true;
-                k_condvar_signal(&nfc_read_cv);
-            }
-            break;
-
-        case NFC_T4T_EVENT_NDEF_UPDATED:
-            LOG_INF("NDEF message updated, new length: %zu", data_length);
-  
-            if (data_length <= 2)
-            {
-                LOG_DBG("First write (NLEN=0), waiting for actual data...");
-                break;
-            }
-
-            if (m_current_op == NDEF_TEST_WRITE)
-            {
-                m_ndef_operation_done = true;
-
-                k_condvar_signal(&nfc_write_cv);
-            }
-
-            break;
-        
-        default:
-            LOG_INF("NFC T4T event: %d", event);
-            break;
-    }
-
-    k_mutex_unlock(&nfc_lock);
-}
-
-/*
- * Build a simple NDEF text record and encode it into the provided buffer.
- */
-static int build_text_ndef(uint8_t *buff, uint32_t size, const uint8_t *data,
-                           size_t data_length, uint32_t *out_length)
-{
-    int err;
-    uint32_t ndef_size = nfc_t4t_ndef_file_msg_size_get(size);
-    const uint8_t en_code[] = {'e', 'n'};
-
-    NFC_NDEF_TEXT_RECORD_DESC_DEF(text_record,
-                    UTF_8,
-                    en_code,
-                    sizeof(en_code),
-                    data,
-                    data_length);
-
-    NFC_NDEF_MSG_DEF(nfc_text_msg, MAX_REC_COUNT);
-
-    err = nfc_ndef_msg_record_add(&NFC_NDEF_MSG(nfc_text_msg),
-                    &NFC_NDEF_TEXT_RECORD_DESC(text_record));
-
-    if (err < 0)
-    {
-        LOG_ERR("Record add failed");
-        return err;
-    }
-    
-    err = nfc_ndef_msg_encode(&NFC_NDEF_MSG(nfc_text_msg),
-                              nfc_t4t_ndef_file_msg_get(buff),
-                              &ndef_size);
-
-    if (err < 0)
-    {
-        LOG_ERR("Encode failed");
-        return err;
-    }
-
-	err = nfc_t4t_ndef_file_encode(buff, &ndef_size);
-	if (err) 
-    {
-        LOG_ERR("nfc_t4t_ndef_file_encode() failed! err = %d", err);
-		return err;
-	}
-
-    *out_length = ndef_size;
-
-    return 0;
-}
-
-static int wait_with_timeout(struct k_condvar *cv,
-                             struct k_mutex *mutex,
-                             volatile bool *condition,
-                             uint32_t timeout_ms)
-{
-    uint32_t start = k_uptime_get_32();
-
-    while (!*condition) 
-    {
-        uint32_t elapsed = k_uptime_get_32() - start;
-
-        if (elapsed >= timeout_ms) 
-        {
-            return -ETIMEDOUT;
-        }
-
-        uint32_t remaining = timeout_ms - elapsed;
-        k_condvar_wait(cv, mutex, K_MSEC(remaining));
-    }
-
-    return 0;
-}
-
-/*
- * Start NFC tag emulation with a static (read-only) payload.
- * Wait until a phone reads the message.
- */
-static int nfctest_send_data(const uint8_t *data, size_t data_length, uint32_t timeout_ms)
-{
-    int err;
-
-    if (data == NULL || data_length == 0)
-    {
-        LOG_ERR("No NFC data provided");
-        return -EINVAL;
-    }
-
-    LOG_INF("Encoding NFC message...");
-
-    memset(m_ndef_msg_buf, 0, sizeof(m_ndef_msg_buf));
-
-    size_t size_in = sizeof(m_ndef_msg_buf);
-    uint32_t encoded_len = 0;
-
-    if (build_text_ndef(m_ndef_msg_buf, size_in, data, data_length, &encoded_len) < 0)
-    {
-        LOG_ERR("Failed to build NDEF, cannot encode message");
-        return -EIO;
-    }
-    m_ndef_len = encoded_len;
-
-    if (nfc_t4t_ndef_staticpayload_set(m_ndef_msg_buf, m_ndef_len) < 0)
-    {
-        LOG_ERR("Payload set failed");
-        return -EIO;
-    }
-
-    if (nfc_t4t_emulation_start() < 0)
-    {
-        LOG_ERR("Emulation start failed");
-        return -EIO;
-    }
-
-    LOG_INF("NFC message ready for Read, approach with phone");
-
-    /* Wait for NDEF read event from callback */
-    k_mutex_lock(&nfc_lock, K_FOREVER);
-    m_current_op = NDEF_TEST_READ;
-    m_ndef_operation_done = false;
-    m_field_off = false;
-
-    err = wait_with_timeout(&nfc_read_cv,
-                            &nfc_lock,
-                            &m_ndef_operation_done,
-                            timeout_ms);
-    if (err < 0) 
-    {
-        k_mutex_unlock(&nfc_lock);
-        nfc_t4t_emulation_stop();
-        return err;
-    }
-
-    err = wait_with_timeout(&nfc_read_cv,
-                            &nfc_lock,
-                            &m_field_off,
-                            timeout_ms);
-    if (err < 0) 
-    {
-        k_mutex_unlock(&nfc_lock);
-        nfc_t4t_emulation_stop();
-        return err;
-    }
-
-    m_current_op = NDEF_OP_NONE;
-    k_mutex_unlock(&nfc_lock);
-
-    nfc_t4t_emulation_stop();
-    LOG_INF("NDEF read done, emulation stopped");
-
-    return 0;
-}
-
-/*
- * Start NFC tag emulation in read/write mode.
- * Wait until a phone writes a new NDEF message.
- */
-static int nfctest_receive_data(const uint8_t *data, size_t *data_length, uint32_t timeout_ms)
-{   
-    int err;
-
-    memset(m_ndef_msg_buf, 0, sizeof(m_ndef_msg_buf));
-    m_ndef_len = sizeof(m_ndef_msg_buf);
-
-    if (nfc_t4t_ndef_rwpayload_set(m_ndef_msg_buf, m_ndef_len) < 0)
-    {
-        LOG_ERR("Payload set failed");
-        return -1;
-    }
-
-    if (nfc_t4t_emulation_start() < 0)
-    {
-        LOG_ERR("Emulation start failed");
-        return -1;
-    }
-
-    LOG_INF("NFC message ready for Read/Write, approach with phone");
-
-    /* Wait for NDEF write event from callback*/
-    k_mutex_lock(&nfc_lock, K_FOREVER);
-    m_current_op = NDEF_TEST_WRITE;
-    m_ndef_operation_done = false;
-    m_field_off = false;
-
-    err = wait_with_timeout(&nfc_write_cv,
-                            &nfc_lock,
-                            &m_ndef_operation_done,
-                            timeout_ms);
-    if (err < 0) 
-    {
-        k_mutex_unlock(&nfc_lock);
-        nfc_t4t_emulation_stop();
-        return err;
-    }
-
-    err = wait_with_timeout(&nfc_write_cv,
-                            &nfc_lock,
-                            &m_field_off,
-                            timeout_ms);
-    if (err < 0) 
-    {
-        k_mutex_unlock(&nfc_lock);
-        nfc_t4t_emulation_stop();
-        return err;
-    }
-
-    m_current_op = NDEF_OP_NONE;
-    k_mutex_unlock(&nfc_lock);
-
-    nfc_t4t_emulation_stop();
-    LOG_INF("NDEF write done, emulation stopped");
-
-    err = handle_ndef_text_record(m_ndef_msg_buf, m_ndef_len, (uint8_t *)data, data_length);
-    
-    if (err < 0)
-    {
-        return err;
-    }
-
-    return 0;
-}
-
-static int nfctest_t4t_setup(void)
-{
-    if (m_nfc_t4t_initialized) 
-    {
-        return 0;
-    }
-
-    int err = nfc_t4t_setup(nfc_t4t_callback, NULL);
-    if (err < 0) 
-    {
-        LOG_ERR("nfc_t4t_setup failed (%d)", err);
-        return err;
-    }
-
-    m_nfc_t4t_initialized = true;
-    LOG_INF("NFC T4T initialized");
-
-    return 0;
-}
-
-int nfctest(int mode, uint8_t *data, size_t *data_length, uint32_t timeout_ms)
-{
-    if (!data || !data_length)
-    {
-        return -EINVAL;
-    }
-
-    if (mode == 1)
-    {
-        LOG_INF("NFCTEST MODE 1 START");
-
-        if (*data_length == 0)
-        {
-            LOG_WRN("No data to send");
-            return -EINVAL;
-        }
-
-        int err = nfctest_t4t_setup();
-        if (err < 0) 
-        {
-            return err;
-        }
-
-        return nfctest_send_data(data, *data_length, timeout_ms);
-    }
-    else if (mode == 2)
-    {
-        LOG_INF("NFCTEST MODE 2 START");
-
-        memset(data, 0, NFCTEST_PAYLOAD_MAX);
-        *data_length = 0;
-
-        int err = nfctest_t4t_setup();
-        if (err < 0) 
-        {
-            return err;
-        }
-
-        int ret = nfctest_receive_data(data, data_length, timeout_ms);
-
-        if (ret == 0)
-        {
-            LOG_INF("RX PAYLOAD: %s", data);
-        }
-
-        return ret;
-    }
-
-    return -EINVAL;
-}
+#include <zephyr/kernel.h>
+#include <nfc/ndef/msg.h>
+#include <nfc/ndef/text_rec.h>
+#include <nfc/t4t/ndef_file.h>
+#include <nfc_t4t_lib.h>
+#include <nfc/ndef/msg_parser.h>
+#include <zephyr/logging/log.h>
+#include "nfc_test.h"
+#include "crc32_engine.h"
+
+LOG_MODULE_REGISTER(nfctest);
+
+K_MUTEX_DEFINE(nfc_lock);
+K_MUTEX_DEFINE(nfc_stage_lock);
+K_EVENT_DEFINE(nfc_events);
+K_SEM_DEFINE(nfc_event_sem, 0, 1);
+K_THREAD_STACK_DEFINE(nfc_event_stack, NFCTEST_EVENT_STACK_SIZE);
+
+BUILD_ASSERT((NFCTEST_EVENT_RING_LEN & (NFCTEST_EVENT_RING_LEN - 1)) == 0,
+             "NFCTEST_EVENT_RING_LEN must be a power of two");
+
+/*
+ * Library callback to worker thread. Single producer, single consumer: the
+ * callback only writes m_event_head, the worker only writes m_event_tail.
+ */
+static struct nfctest_event m_event_ring[NFCTEST_EVENT_RING_LEN];
+static atomic_t m_event_head;
+static atomic_t m_event_tail;
+static atomic_t m_events_dropped;     /* never reset, the worker compares it */
+static uint32_t m_events_handled;     /* under nfc_lock, catches up with m_event_head */
+static struct k_thread nfc_event_thread;
+static bool m_event_worker_started;
+
+/* Handled events, under nfc_lock */
+static struct nfctest_event m_trace[NFCTEST_EVENT_RING_LEN];
+static uint32_t m_trace_count;
+static uint32_t m_trace_dropped_base;  /* m_events_dropped at the last trace clear */
+
+/*
+ * Phase latencies, under nfc_lock. The reader phases are measured between
+ * the callback timestamps of consecutive events.
+ */
+static struct nfctest_phase_stats m_phase_stats[NFCTEST_PHASE_COUNT];
+static uint32_t m_emulation_started;    /* cycles, for the first FIELD_ON */
+static uint32_t m_field_on_at;
+static uint32_t m_ndef_at;
+static bool m_wait_field_on;
+static bool m_wait_ndef;
+static bool m_wait_field_off;
+
+/* nfc_events bits */
+#define NFC_EVT_DONE        BIT(0)  /* the one-shot read or write happened */
+#define NFC_EVT_FIELD_OFF   BIT(1)  /* the reader left after NFC_EVT_DONE */
+#define NFC_EVT_FIELD_IDLE  BIT(2)  /* the reader left, any time */
+#define NFC_EVT_ERROR       BIT(3)  /* events were lost */
+#define NFC_EVT_CANCEL      BIT(4)  /* nfctest_abort() */
+#define NFC_EVT_DRAINED     BIT(5)  /* every queued event was handled */
+#define NFC_EVT_ALL         (NFC_EVT_DONE | NFC_EVT_FIELD_OFF | NFC_EVT_FIELD_IDLE | \
+                             NFC_EVT_ERROR | NFC_EVT_CANCEL | NFC_EVT_DRAINED)
+
+static bool m_ndef_operation_done;
+
+/* Writable tag file for mode 2 */
+static uint8_t m_ndef_msg_buf[NDEF_MSG_BUF_SIZE];
+static uint32_t m_ndef_len = NDEF_MSG_BUF_SIZE;
+
+static bool m_nfc_t4t_initialized;
+
+BUILD_ASSERT(NFCTEST_PAYLOAD_SLOTS >= 2, "Payload staging needs a spare slot");
+
+/* An encoded T4T NDEF file and the text it was built from */
+struct ndef_file
+{
+    uint8_t buf[NDEF_MSG_BUF_SIZE];
+    uint32_t len;               /* 0 while empty */
+    uint32_t hash;              /* CRC-32 of the text */
+    uint32_t hits;
+    uint8_t text_len;
+    uint8_t text[NFCTEST_PAYLOAD_MAX];
+};
+
+/*
+ * Static payloads. The library serves reads from the active file. The next
+ * message is encoded into a staging slot that is not active, or taken from
+ * the message cache as is, under nfc_stage_lock and swapped in under
+ * nfc_lock.
+ */
+static struct ndef_file m_ndef_slots[NFCTEST_PAYLOAD_SLOTS];
+static struct ndef_file m_msg_cache[NFCTEST_MSG_CACHE_SLOTS];
+static struct ndef_file *m_active_file;
+static struct ndef_file *m_staged_file;
+static size_t m_next_slot;
+
+/* Persistent emulation, see nfctest_persist_start() */
+static bool m_field_present;
+static struct nfctest_persist_status m_persist;
+static struct nfctest_read_record m_read_log[NFCTEST_READ_LOG_LEN];
+
+uint32_t timeout_ms = NFCTEST_RW_TIMEOUT_DEFAULT_MS;
+
+typedef enum
+{
+    NDEF_OP_NONE,
+    NDEF_TEST_READ,
+    NDEF_TEST_WRITE
+} ndef_op;
+
+static ndef_op m_current_op = NDEF_OP_NONE;
+static bool m_nfctest_running;
+static bool m_swap_waiting;     /* persist_swap_staged() waits for the reader to leave */
+
+/* Parse a TEXT NDEF record written by an NFC reader/writer (e.g. a smartphone) and extract its payload */
+static int handle_ndef_text_record(const uint8_t *data, size_t data_length, uint8_t *payload_buf,
+                                         size_t *payload_len)
+{
+    int err;
+
+    if (!data || data_length <= 2)
+    {
+        LOG_WRN("NDEF data too short");
+        return -EINVAL;
+    }
+
+    /* Skip NLEN (2 bytes) */
+    const uint8_t *ndef_msg_buf = data + 2;
+    uint32_t ndef_msg_len = data_length - 2;
+
+    struct nfc_ndef_bin_payload_desc bin_payload;
+    struct nfc_ndef_record_desc record;
+    enum nfc_ndef_record_location record_location;
+
+    /* Parse first NDEF record */
+    err = nfc_ndef_record_parse(&bin_payload,
+                                &record,
+                                &record_location,
+                                ndef_msg_buf,
+                                &ndef_msg_len);
+    if (err)
+    {
+        LOG_ERR("NDEF record parse failed (%d)", err);
+        return err;
+    }
+
+    /* Verify TEXT record */
+    if (record.tnf != TNF_WELL_KNOWN ||
+        record.type_length != 1 ||
+        record.type[0] != 'T')
+    {
+        LOG_WRN("Not a TEXT record");
+        return -ENOTSUP;
+    }
+
+    /* Validate payload */
+    if (bin_payload.payload_length < 1)
+    {
+        LOG_ERR("Invalid TEXT payload length");
+        return -EINVAL;
+    }
+
+    const uint8_t *payload = bin_payload.payload;
+    uint32_t payload_length = bin_payload.payload_length;
+
+    uint8_t status = payload[0];
+    uint8_t lang_len = status & 0x3F;
+
+    if (payload_length < (1 + lang_len))
+    {
+        LOG_ERR("Invalid language code length");
+        return -EINVAL;
+    }
+
+    const uint8_t *text = &payload[1 + lang_len];
+    uint32_t text_len = payload_length - 1 - lang_len;
+
+    uint32_t copy_len = MIN(text_len, NFCTEST_PAYLOAD_MAX - 1);
+
+    memcpy(payload_buf, text, copy_len);
+    payload_buf[copy_len] = '\0';
+    *payload_len = copy_len;
+
+    LOG_INF("NFC RX TEXT: %s", payload_buf);
+
+    return 0;
+}
+
+static void phase_record(enum nfctest_phase phase, uint32_t cycles)
+{
+    uint32_t us = k_cyc_to_us_floor32(cycles);
+    struct nfctest_phase_stats *st = &m_phase_stats[phase];
+    size_t bucket = (us == 0) ? 0 : 32 - __builtin_clz(us);
+
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    if (st->count == 0 || us < st->min_us)
+    {
+        st->min_us = us;
+    }
+
+    st->max_us = MAX(st->max_us, us);
+    st->sum_us += us;
+    st->count++;
+    st->buckets[MIN(bucket, (size_t)NFCTEST_HIST_BUCKETS - 1)]++;
+
+    k_mutex_unlock(&nfc_lock);
+}
+
+/*
+ * NFC Type 4 Tag event callback.
+ * Called by the NFC library whenever a field is detected, removed,
+ * or an NDEF message is read/written by a phone. Only queues the event,
+ * nfc_event_handle() acts on it from the worker thread.
+ */
+static void nfc_t4t_callback(void *context,
+                    nfc_t4t_event_t event,
+                    const uint8_t *data,
+                    size_t data_length,
+                    uint32_t flags)
+{
+    ARG_UNUSED(context);
+    ARG_UNUSED(data);
+    ARG_UNUSED(flags);
+
+    uint32_t head = (uint32_t)atomic_get(&m_event_head);
+
+    if (head - (uint32_t)atomic_get(&m_event_tail) >= NFCTEST_EVENT_RING_LEN)
+    {
+        atomic_inc(&m_events_dropped);
+        return;
+    }
+
+    m_event_ring[head & (NFCTEST_EVENT_RING_LEN - 1)] = (struct nfctest_event){
+        .cycles = k_cycle_get_32(),
+        .length = data_length,
+        .type = event,
+    };
+
+    /* Publishes the entry, atomics are full barriers */
+    atomic_set(&m_event_head, head + 1);
+
+    k_sem_give(&nfc_event_sem);
+}
+
+/* First NDEF read or update of a tap, called with nfc_lock held */
+static void phase_ndef(uint32_t cycles)
+{
+    if (m_wait_ndef)
+    {
+        phase_record(NFCTEST_PHASE_NDEF, cycles - m_field_on_at);
+        m_wait_ndef = false;
+    }
+
+    m_ndef_at = cycles;
+    m_wait_field_off = true;
+}
+
+static void nfc_event_handle(const struct nfctest_event *ev)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    m_trace[m_trace_count & (NFCTEST_EVENT_RING_LEN - 1)] = *ev;
+    m_trace_count++;
+
+    switch (ev->type)
+    {
+        case NFC_T4T_EVENT_FIELD_ON:
+            LOG_INF("NFC field detected: phone is near");
+            m_field_present = true;
+            m_field_on_at = ev->cycles;
+            m_wait_ndef = true;
+
+            if (m_wait_field_on)
+            {
+                phase_record(NFCTEST_PHASE_FIELD_ON, ev->cycles - m_emulation_started);
+                m_wait_field_on = false;
+            }
+
+            if (m_persist.active)
+            {
+                m_persist.taps++;
+            }
+            break;
+
+        case NFC_T4T_EVENT_FIELD_OFF:
+            LOG_INF("NFC field lost: phone moved away");
+            m_field_present = false;
+            m_wait_ndef = false;
+
+            if (m_wait_field_off)
+            {
+                phase_record(NFCTEST_PHASE_FIELD_OFF, ev->cycles - m_ndef_at);
+                m_wait_field_off = false;
+            }
+
+            k_event_post(&nfc_events, m_ndef_operation_done ?
+                         (NFC_EVT_FIELD_OFF | NFC_EVT_FIELD_IDLE) : NFC_EVT_FIELD_IDLE);
+            break;
+
+        case NFC_T4T_EVENT_NDEF_READ:
+            LOG_INF("NDEF message read, length: %zu", (size_t)ev->length);
+            phase_ndef(ev->cycles);
+
+            if (m_persist.active)
+            {
+                struct nfctest_read_record *rec =
+                    &m_read_log[m_persist.reads % NFCTEST_READ_LOG_LEN];
+
+                m_persist.reads++;
+                rec->seq = m_persist.reads;
+                rec->uptime_ms = k_uptime_get();
+            }
+
+            if (m_current_op == NDEF_TEST_READ)
+            {
+                m_ndef_operation_done = true;
+                k_event_post(&nfc_events, NFC_EVT_DONE);
+            }
+            break;
+
+        case NFC_T4T_EVENT_NDEF_UPDATED:
+            LOG_INF("NDEF message updated, new length: %zu", (size_t)ev->length);
+  
+            if ((size_t)ev->length <= 2)
+            {
+                LOG_DBG("First write (NLEN=0), waiting for actual data...");
+                break;
+            }
+
+            phase_ndef(ev->cycles);
+
+            if (m_current_op == NDEF_TEST_WRITE)
+            {
+                m_ndef_operation_done = true;
+                k_event_post(&nfc_events, NFC_EVT_DONE);
+            }
+
+            break;
+        
+        default:
+            LOG_INF("NFC T4T event: %d", ev->type);
+            break;
+    }
+
+    m_events_handled++;
+
+    if (m_swap_waiting && m_events_handled == (uint32_t)atomic_get(&m_event_head))
+    {
+        k_event_post(&nfc_events, NFC_EVT_DRAINED);
+    }
+
+    k_mutex_unlock(&nfc_lock);
+}
+
+/*
+ * Events the callback queued that nfc_event_handle() has not finished yet,
+ * including one the worker took off the ring but is still waiting to
+ * handle. Called with nfc_lock held.
+ */
+static bool nfc_events_pending(void)
+{
+    return m_events_handled != (uint32_t)atomic_get(&m_event_head);
+}
+
+static void nfc_event_worker(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    atomic_val_t dropped = 0;
+
+    while (1)
+    {
+        k_sem_take(&nfc_event_sem, K_FOREVER);
+
+        /*
+        * A lost event could be the one a waiter needs, fail it rather than time
+        * out. Only new drops count, the counter never goes backwards.
+        */
+        atomic_val_t now = atomic_get(&m_events_dropped);
+
+        if (now != dropped)
+        {
+            dropped = now;
+            LOG_ERR("NFC event queue overflow");
+            k_event_post(&nfc_events, NFC_EVT_ERROR);
+        }
+
+        uint32_t tail = (uint32_t)atomic_get(&m_event_tail);
+
+        while (tail != (uint32_t)atomic_get(&m_event_head))
+        {
+            struct nfctest_event ev = m_event_ring[tail & (NFCTEST_EVENT_RING_LEN - 1)];
+
+            /* Hand the entry back before the slow part */
+            tail++;
+            atomic_set(&m_event_tail, tail);
+
+            nfc_event_handle(&ev);
+        }
+    }
+}
+
+/*
+ * Build a simple NDEF text record and encode it into the provided buffer.
+ */
+static int build_text_ndef(uint8_t *buff, uint32_t size, const uint8_t *data,
+                           size_t data_length, uint32_t *out_length)
+{
+    int err;
+    uint32_t ndef_size = nfc_t4t_ndef_file_msg_size_get(size);
+    const uint8_t en_code[] = {'e', 'n'};
+
+    NFC_NDEF_TEXT_RECORD_DESC_DEF(text_record,
+                    UTF_8,
+                    en_code,
+                    sizeof(en_code),
+                    data,
+                    data_length);
+
+    NFC_NDEF_MSG_DEF(nfc_text_msg, MAX_REC_COUNT);
+
+    err = nfc_ndef_msg_record_add(&NFC_NDEF_MSG(nfc_text_msg),
+                    &NFC_NDEF_TEXT_RECORD_DESC(text_record));
+
+    if (err < 0)
+    {
+        LOG_ERR("Record add failed");
+        return err;
+    }
+    
+    err = nfc_ndef_msg_encode(&NFC_NDEF_MSG(nfc_text_msg),
+                              nfc_t4t_ndef_file_msg_get(buff),
+                              &ndef_size);
+
+    if (err < 0)
+    {
+        LOG_ERR("Encode failed");
+        return err;
+    }
+
+	err = nfc_t4t_ndef_file_encode(buff, &ndef_size);
+	if (err) 
+    {
+        LOG_ERR("nfc_t4t_ndef_file_encode() failed! err = %d", err);
+		return err;
+	}
+
+    *out_length = ndef_size;
+
+    return 0;
+}
+
+static int emulation_start(void)
+{
+    uint32_t start = k_cycle_get_32();
+    int err = nfc_t4t_emulation_start();
+    uint32_t end = k_cycle_get_32();
+
+    if (err < 0)
+    {
+        return err;
+    }
+
+    phase_record(NFCTEST_PHASE_START, end - start);
+
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    m_emulation_started = end;
+    m_wait_field_on = true;
+    k_mutex_unlock(&nfc_lock);
+
+    return 0;
+}
+
+static void emulation_stop(void)
+{
+    uint32_t start = k_cycle_get_32();
+
+    nfc_t4t_emulation_stop();
+    phase_record(NFCTEST_PHASE_STOP, k_cycle_get_32() - start);
+}
+
+/* Set up a one-shot read or write, before emulation starts */
+static void transaction_begin(ndef_op op)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    m_current_op = op;
+    m_ndef_operation_done = false;
+
+    /* A cancel since nfctest() was called still counts */
+    k_event_clear(&nfc_events, NFC_EVT_ALL & ~NFC_EVT_CANCEL);
+    k_mutex_unlock(&nfc_lock);
+}
+
+/*
+ * Wait until the reader has done the operation and left the field, then stop
+ * emulation. The deadline covers the whole transaction, a cancel or lost
+ * events end it at once.
+ */
+static int transaction_end(k_timepoint_t deadline)
+{
+    uint32_t ev = k_event_wait(&nfc_events, NFC_EVT_FIELD_OFF | NFC_EVT_CANCEL | NFC_EVT_ERROR,
+                               false, sys_timepoint_timeout(deadline));
+    int err = 0;
+
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    if (ev & NFC_EVT_CANCEL)
+    {
+        LOG_WRN("NFC test cancelled");
+        err = -ECANCELED;
+    }
+    else if (ev & NFC_EVT_ERROR)
+    {
+        err = -EIO;
+    }
+    else if (ev == 0)
+    {
+        LOG_WRN(m_ndef_operation_done ? "Reader did not leave the field" : "No reader");
+        err = -ETIMEDOUT;
+    }
+
+    m_current_op = NDEF_OP_NONE;
+    k_mutex_unlock(&nfc_lock);
+
+    emulation_stop();
+
+    return err;
+}
+
+static uint32_t ndef_text_hash(const uint8_t *data, size_t data_length)
+{
+    return crc32_engine_compute(&crc32_variant_bzip2, data, data_length);
+}
+
+static bool ndef_file_matches(const struct ndef_file *f, const uint8_t *data,
+                              size_t data_length, uint32_t hash)
+{
+    return f->len != 0 && f->hash == hash && f->text_len == data_length &&
+           memcmp(f->text, data, data_length) == 0;
+}
+
+static int ndef_file_encode(struct ndef_file *f, const uint8_t *data, size_t data_length,
+                            uint32_t hash)
+{
+    uint32_t encoded_len = 0;
+
+    if (data_length >= NFCTEST_PAYLOAD_MAX)
+    {
+        return -EINVAL;
+    }
+
+    memset(f, 0, sizeof(*f));
+
+    if (build_text_ndef(f->buf, sizeof(f->buf), data, data_length, &encoded_len) < 0)
+    {
+        LOG_ERR("Failed to build NDEF, cannot encode message");
+        memset(f, 0, sizeof(*f));
+        return -EIO;
+    }
+
+    f->len = encoded_len;
+    f->hash = hash;
+    f->text_len = data_length;
+    memcpy(f->text, data, data_length);
+
+    return 0;
+}
+
+/*
+ * Stage a text message. A cached or recently sent copy is used without
+ * encoding, otherwise the message is encoded into a staging slot that is not
+ * being served. Called with nfc_stage_lock held.
+ */
+static int ndef_text_stage(const uint8_t *data, size_t data_length)
+{
+    uint32_t hash = ndef_text_hash(data, data_length);
+    struct ndef_file *f;
+
+    for (size_t i = 0; i < NFCTEST_MSG_CACHE_SLOTS; i++)
+    {
+        if (ndef_file_matches(&m_msg_cache[i], data, data_length, hash))
+        {
+            m_msg_cache[i].hits++;
+            m_staged_file = &m_msg_cache[i];
+            return 0;
+        }
+    }
+
+    for (size_t i = 0; i < NFCTEST_PAYLOAD_SLOTS; i++)
+    {
+        if (ndef_file_matches(&m_ndef_slots[i], data, data_length, hash))
+        {
+            m_ndef_slots[i].hits++;
+            m_staged_file = &m_ndef_slots[i];
+            return 0;
+        }
+    }
+
+    f = &m_ndef_slots[m_next_slot];
+    if (f == m_active_file)
+    {
+        m_next_slot = (m_next_slot + 1) % NFCTEST_PAYLOAD_SLOTS;
+        f = &m_ndef_slots[m_next_slot];
+    }
+    m_next_slot = (m_next_slot + 1) % NFCTEST_PAYLOAD_SLOTS;
+
+    int err = ndef_file_encode(f, data, data_length, hash);
+
+    if (err < 0)
+    {
+        return err;
+    }
+
+    m_staged_file = f;
+
+    return 0;
+}
+
+/*
+ * The library reads f right now: persistent emulation or a one-shot test
+ * runs with it. m_active_file alone only names the last file served.
+ * Called with nfc_lock held.
+ */
+static bool ndef_file_served(const struct ndef_file *f)
+{
+    return f == m_active_file && (m_persist.active || m_nfctest_running);
+}
+
+/* Serve the staged file. Called with nfc_lock held */
+static int ndef_file_activate(void)
+{
+    struct ndef_file *f = m_staged_file;
+
+    m_staged_file = NULL;
+
+    if (f == NULL)
+    {
+        return -ENOENT;
+    }
+
+    int err = nfc_t4t_ndef_staticpayload_set(f->buf, f->len);
+
+    if (err == -EFAULT && m_persist.active)
+    {
+        /* The library refuses a new payload while emulating, restart around it */
+        emulation_stop();
+        err = nfc_t4t_ndef_staticpayload_set(f->buf, f->len);
+
+        if (emulation_start() < 0)
+        {
+            LOG_ERR("Emulation restart failed");
+            m_persist.active = false;
+            return -EIO;
+        }
+    }
+
+    if (err < 0)
+    {
+        LOG_ERR("Payload set failed");
+        return -EIO;
+    }
+
+    m_active_file = f;
+
+    return 0;
+}
+
+/*
+ * Start NFC tag emulation with a static (read-only) payload.
+ * Wait until a phone reads the message.
+ */
+static int nfctest_send_data(const uint8_t *data, size_t data_length, uint32_t timeout_ms)
+{
+    k_timepoint_t deadline = sys_timepoint_calc(K_MSEC(timeout_ms));
+    int err;
+
+    if (data == NULL || data_length == 0)
+    {
+        LOG_ERR("No NFC data provided");
+        return -EINVAL;
+    }
+
+    LOG_INF("Encoding NFC message...");
+
+    k_mutex_lock(&nfc_stage_lock, K_FOREVER);
+
+    err = ndef_text_stage(data, data_length);
+    if (err == 0)
+    {
+        k_mutex_lock(&nfc_lock, K_FOREVER);
+        err = ndef_file_activate();
+        k_mutex_unlock(&nfc_lock);
+    }
+
+    k_mutex_unlock(&nfc_stage_lock);
+
+    if (err < 0)
+    {
+        return err;
+    }
+
+    transaction_begin(NDEF_TEST_READ);
+
+    if (emulation_start() < 0)
+    {
+        transaction_begin(NDEF_OP_NONE);
+        LOG_ERR("Emulation start failed");
+        return -EIO;
+    }
+
+    LOG_INF("NFC message ready for Read, approach with phone");
+
+    err = transaction_end(deadline);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    LOG_INF("NDEF read done, emulation stopped");
+
+    return 0;
+}
+
+/*
+ * Start NFC tag emulation in read/write mode.
+ * Wait until a phone writes a new NDEF message.
+ */
+static int nfctest_receive_data(const uint8_t *data, size_t *data_length, uint32_t timeout_ms)
+{   
+    k_timepoint_t deadline = sys_timepoint_calc(K_MSEC(timeout_ms));
+    int err;
+
+    memset(m_ndef_msg_buf, 0, sizeof(m_ndef_msg_buf));
+    m_ndef_len = sizeof(m_ndef_msg_buf);
+
+    if (nfc_t4t_ndef_rwpayload_set(m_ndef_msg_buf, m_ndef_len) < 0)
+    {
+        LOG_ERR("Payload set failed");
+        return -1;
+    }
+
+    transaction_begin(NDEF_TEST_WRITE);
+
+    if (emulation_start() < 0)
+    {
+        transaction_begin(NDEF_OP_NONE);
+        LOG_ERR("Emulation start failed");
+        return -1;
+    }
+
+    LOG_INF("NFC message ready for Read/Write, approach with phone");
+
+    err = transaction_end(deadline);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    LOG_INF("NDEF write done, emulation stopped");
+
+    err = handle_ndef_text_record(m_ndef_msg_buf, m_ndef_len, (uint8_t *)data, data_length);
+    
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return 0;
+}
+
+/*
+ * Called from the shell and the job thread, so the check and the init run
+ * under nfc_lock. The callback does not take it.
+ */
+static int nfctest_t4t_setup(void)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    if (m_nfc_t4t_initialized) 
+    {
+        k_mutex_unlock(&nfc_lock);
+        return 0;
+    }
+
+    /* Once only, a failed nfc_t4t_setup() below may be retried */
+    if (!m_event_worker_started)
+    {
+        /* Ahead of the CRC workers so a busy check does not delay NFC events */
+        k_thread_create(&nfc_event_thread, nfc_event_stack,
+                        K_THREAD_STACK_SIZEOF(nfc_event_stack),
+                        nfc_event_worker, NULL, NULL, NULL,
+                        K_LOWEST_APPLICATION_THREAD_PRIO - 1, 0, K_NO_WAIT);
+        k_thread_name_set(&nfc_event_thread, "nfc_event");
+        m_event_worker_started = true;
+    }
+
+    uint32_t start = k_cycle_get_32();
+    int err = nfc_t4t_setup(nfc_t4t_callback, NULL);
+    if (err < 0) 
+    {
+        k_mutex_unlock(&nfc_lock);
+        LOG_ERR("nfc_t4t_setup failed (%d)", err);
+        return err;
+    }
+
+    phase_record(NFCTEST_PHASE_SETUP, k_cycle_get_32() - start);
+    m_nfc_t4t_initialized = true;
+
+    k_mutex_unlock(&nfc_lock);
+
+    LOG_INF("NFC T4T initialized");
+
+    return 0;
+}
+
+static int nfctest_run(int mode, uint8_t *data, size_t *data_length, uint32_t timeout_ms)
+{
+    if (mode == 1)
+    {
+        LOG_INF("NFCTEST MODE 1 START");
+
+        if (*data_length == 0)
+        {
+            LOG_WRN("No data to send");
+            return -EINVAL;
+        }
+
+        int err = nfctest_t4t_setup();
+        if (err < 0) 
+        {
+            return err;
+        }
+
+        return nfctest_send_data(data, *data_length, timeout_ms);
+    }
+    else if (mode == 2)
+    {
+        LOG_INF("NFCTEST MODE 2 START");
+
+        memset(data, 0, NFCTEST_PAYLOAD_MAX);
+        *data_length = 0;
+
+        int err = nfctest_t4t_setup();
+        if (err < 0) 
+        {
+            return err;
+        }
+
+        int ret = nfctest_receive_data(data, data_length, timeout_ms);
+
+        if (ret == 0)
+        {
+            LOG_INF("RX PAYLOAD: %s", data);
+        }
+
+        return ret;
+    }
+
+    return -EINVAL;
+}
+
+int nfctest(int mode, uint8_t *data, size_t *data_length, uint32_t timeout_ms)
+{
+    if (!data || !data_length)
+    {
+        return -EINVAL;
+    }
+
+    int ret = 0;
+
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    if (m_persist.active)
+    {
+        LOG_WRN("Persistent emulation running, stop it first");
+        ret = -EBUSY;
+    }
+    else if (m_nfctest_running)
+    {
+        /* The shell and the job thread may both call in */
+        LOG_WRN("Another NFC test is running");
+        ret = -EBUSY;
+    }
+    else
+    {
+        m_nfctest_running = true;
+        k_event_clear(&nfc_events, NFC_EVT_CANCEL);
+    }
+
+    k_mutex_unlock(&nfc_lock);
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    ret = nfctest_run(mode, data, data_length, timeout_ms);
+
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    m_nfctest_running = false;
+    k_mutex_unlock(&nfc_lock);
+
+    return ret;
+}
+
+/* Start serving the staged file. Called with nfc_stage_lock held */
+static int persist_start_staged(void)
+{
+    int err = nfctest_t4t_setup();
+
+    if (err < 0)
+    {
+        m_staged_file = NULL;
+        return err;
+    }
+
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    if (m_persist.active || m_nfctest_running)
+    {
+        m_staged_file = NULL;
+        k_mutex_unlock(&nfc_lock);
+        return -EBUSY;
+    }
+
+    err = ndef_file_activate();
+
+    if (err == 0 && emulation_start() < 0)
+    {
+        LOG_ERR("Emulation start failed");
+        err = -EIO;
+    }
+
+    if (err == 0)
+    {
+        memset(m_read_log, 0, sizeof(m_read_log));
+        m_persist = (struct nfctest_persist_status){
+            .active = true,
+            .started_ms = k_uptime_get(),
+        };
+        m_field_present = false;
+    }
+
+    k_mutex_unlock(&nfc_lock);
+
+    if (err == 0)
+    {
+        LOG_INF("Persistent emulation started");
+    }
+
+    return err;
+}
+
+/*
+ * Serve the staged file in place of the current one, between reader
+ * transactions so a reader never sees two messages. m_field_present is
+ * only updated by the worker, so a FIELD_ON still queued counts as a
+ * reader too. Called with nfc_stage_lock held.
+ */
+static int persist_swap_staged(void)
+{
+    k_timepoint_t deadline = sys_timepoint_calc(K_MSEC(NFCTEST_SWAP_TIMEOUT_MS));
+    int err = 0;
+
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    m_swap_waiting = true;
+
+    while ((m_field_present || nfc_events_pending()) && err == 0)
+    {
+        /* Cleared under nfc_lock, so an event handled after the check still wakes us */
+        k_event_clear(&nfc_events, NFC_EVT_FIELD_IDLE | NFC_EVT_DRAINED | NFC_EVT_CANCEL);
+        k_mutex_unlock(&nfc_lock);
+
+        uint32_t ev = k_event_wait(&nfc_events,
+                                   NFC_EVT_FIELD_IDLE | NFC_EVT_DRAINED | NFC_EVT_CANCEL,
+                                   false, sys_timepoint_timeout(deadline));
+
+        k_mutex_lock(&nfc_lock, K_FOREVER);
+
+        if (ev & NFC_EVT_CANCEL)
+        {
+            err = -ECANCELED;
+        }
+        else if (ev == 0)
+        {
+            err = -EBUSY;
+        }
+    }
+
+    m_swap_waiting = false;
+
+    if (err == 0 && !m_persist.active)
+    {
+        err = -ENODEV;
+    }
+
+    if (err == 0)
+    {
+        err = ndef_file_activate();
+    }
+
+    if (err == 0)
+    {
+        m_persist.swaps++;
+    }
+
+    m_staged_file = NULL;
+
+    k_mutex_unlock(&nfc_lock);
+
+    return err;
+}
+
+int nfctest_persist_start(const uint8_t *data, size_t data_length)
+{
+    int err;
+
+    if (data == NULL || data_length == 0)
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&nfc_stage_lock, K_FOREVER);
+
+    err = ndef_text_stage(data, data_length);
+    if (err == 0)
+    {
+        err = persist_start_staged();
+    }
+
+    k_mutex_unlock(&nfc_stage_lock);
+
+    return err;
+}
+
+int nfctest_persist_update(const uint8_t *data, size_t data_length)
+{
+    int err;
+
+    if (data == NULL || data_length == 0)
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&nfc_stage_lock, K_FOREVER);
+
+    if (!m_persist.active)
+    {
+        k_mutex_unlock(&nfc_stage_lock);
+        return -ENODEV;
+    }
+
+    /* Encoding does not touch the served file, readers keep being answered */
+    err = ndef_text_stage(data, data_length);
+    if (err == 0)
+    {
+        err = persist_swap_staged();
+    }
+
+    k_mutex_unlock(&nfc_stage_lock);
+
+    return err;
+}
+
+int nfctest_persist_stop(void)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    if (!m_persist.active)
+    {
+        k_mutex_unlock(&nfc_lock);
+        return -ENODEV;
+    }
+
+    emulation_stop();
+    m_persist.active = false;
+
+    uint32_t reads = m_persist.reads;
+
+    k_mutex_unlock(&nfc_lock);
+
+    LOG_INF("Persistent emulation stopped after %u reads", reads);
+
+    return 0;
+}
+
+void nfctest_persist_status_get(struct nfctest_persist_status *status)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    *status = m_persist;
+    k_mutex_unlock(&nfc_lock);
+}
+
+size_t nfctest_persist_reads_get(struct nfctest_read_record *records, size_t max)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    size_t count = MIN(MIN((size_t)m_persist.reads, (size_t)NFCTEST_READ_LOG_LEN), max);
+    uint32_t first = m_persist.reads - count;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        records[i] = m_read_log[(first + i) % NFCTEST_READ_LOG_LEN];
+    }
+
+    k_mutex_unlock(&nfc_lock);
+
+    return count;
+}
+
+int nfctest_msg_cache_load(size_t slot, const uint8_t *data, size_t data_length)
+{
+    int err = 0;
+
+    if (slot >= NFCTEST_MSG_CACHE_SLOTS || data == NULL || data_length == 0)
+    {
+        return -EINVAL;
+    }
+
+    uint32_t hash = ndef_text_hash(data, data_length);
+    struct ndef_file *f = &m_msg_cache[slot];
+
+    k_mutex_lock(&nfc_stage_lock, K_FOREVER);
+
+    /* Serving only starts under nfc_stage_lock, so this holds until we return */
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    bool served = ndef_file_served(f);
+    k_mutex_unlock(&nfc_lock);
+
+    if (ndef_file_matches(f, data, data_length, hash))
+    {
+        /* Already loaded */
+    }
+    else if (served)
+    {
+        err = -EBUSY;
+    }
+    else
+    {
+        err = ndef_file_encode(f, data, data_length, hash);
+    }
+
+    k_mutex_unlock(&nfc_stage_lock);
+
+    return err;
+}
+
+int nfctest_msg_cache_select(size_t slot)
+{
+    int err;
+
+    if (slot >= NFCTEST_MSG_CACHE_SLOTS)
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&nfc_stage_lock, K_FOREVER);
+
+    if (m_msg_cache[slot].len == 0)
+    {
+        k_mutex_unlock(&nfc_stage_lock);
+        return -ENOENT;
+    }
+
+    m_msg_cache[slot].hits++;
+    m_staged_file = &m_msg_cache[slot];
+
+    err = m_persist.active ? persist_swap_staged() : persist_start_staged();
+
+    k_mutex_unlock(&nfc_stage_lock);
+
+    return err;
+}
+
+int nfctest_msg_cache_info_get(size_t slot, struct nfctest_msg_info *info)
+{
+    if (slot >= NFCTEST_MSG_CACHE_SLOTS)
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&nfc_stage_lock, K_FOREVER);
+
+    const struct ndef_file *f = &m_msg_cache[slot];
+
+    if (f->len == 0)
+    {
+        k_mutex_unlock(&nfc_stage_lock);
+        return -ENOENT;
+    }
+
+    info->hash = f->hash;
+    info->hits = f->hits;
+    info->encoded_len = f->len;
+    info->text_len = f->text_len;
+    memcpy(info->text, f->text, f->text_len);
+    info->text[f->text_len] = '\0';
+
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    info->served = ndef_file_served(f);
+    k_mutex_unlock(&nfc_lock);
+
+    k_mutex_unlock(&nfc_stage_lock);
+
+    return 0;
+}
+
+size_t nfctest_msg_cache_clear(void)
+{
+    size_t cleared = 0;
+
+    k_mutex_lock(&nfc_stage_lock, K_FOREVER);
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    for (size_t i = 0; i < NFCTEST_MSG_CACHE_SLOTS; i++)
+    {
+        if (m_msg_cache[i].len != 0 && !ndef_file_served(&m_msg_cache[i]))
+        {
+            memset(&m_msg_cache[i], 0, sizeof(m_msg_cache[i]));
+            cleared++;
+        }
+    }
+
+    k_mutex_unlock(&nfc_lock);
+    k_mutex_unlock(&nfc_stage_lock);
+
+    return cleared;
+}
+
+const char *nfctest_event_name(uint8_t type)
+{
+    switch (type)
+    {
+        case NFC_T4T_EVENT_FIELD_ON:
+            return "FIELD_ON";
+
+        case NFC_T4T_EVENT_FIELD_OFF:
+            return "FIELD_OFF";
+
+        case NFC_T4T_EVENT_NDEF_READ:
+            return "NDEF_READ";
+
+        case NFC_T4T_EVENT_NDEF_UPDATED:
+            return "NDEF_UPDATED";
+
+        default:
+            return "OTHER";
+    }
+}
+
+size_t nfctest_trace_get(struct nfctest_event *events, size_t max, uint32_t *dropped)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    size_t count = MIN(MIN((size_t)m_trace_count, (size_t)NFCTEST_EVENT_RING_LEN), max);
+    uint32_t first = m_trace_count - count;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        events[i] = m_trace[(first + i) & (NFCTEST_EVENT_RING_LEN - 1)];
+    }
+
+    *dropped = (uint32_t)atomic_get(&m_events_dropped) - m_trace_dropped_base;
+
+    k_mutex_unlock(&nfc_lock);
+
+    return count;
+}
+
+void nfctest_trace_clear(void)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    m_trace_count = 0;
+    m_trace_dropped_base = (uint32_t)atomic_get(&m_events_dropped);
+    k_mutex_unlock(&nfc_lock);
+}
+
+const char *nfctest_phase_name(enum nfctest_phase phase)
+{
+    static const char *const names[NFCTEST_PHASE_COUNT] = {
+        [NFCTEST_PHASE_SETUP] = "setup",
+        [NFCTEST_PHASE_START] = "start",
+        [NFCTEST_PHASE_FIELD_ON] = "field_on",
+        [NFCTEST_PHASE_NDEF] = "ndef",
+        [NFCTEST_PHASE_FIELD_OFF] = "field_off",
+        [NFCTEST_PHASE_STOP] = "stop",
+    };
+
+    return (phase < NFCTEST_PHASE_COUNT) ? names[phase] : "?";
+}
+
+void nfctest_phase_stats_get(enum nfctest_phase phase, struct nfctest_phase_stats *stats)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    *stats = m_phase_stats[phase];
+    k_mutex_unlock(&nfc_lock);
+}
+
+uint32_t nfctest_phase_percentile(const struct nfctest_phase_stats *stats, unsigned int pct)
+{
+    uint32_t rank = (uint32_t)(((uint64_t)stats->count * pct + 99) / 100);
+    uint32_t seen = 0;
+
+    if (stats->count == 0)
+    {
+        return 0;
+    }
+
+    for (size_t b = 0; b < NFCTEST_HIST_BUCKETS; b++)
+    {
+        seen += stats->buckets[b];
+
+        if (seen >= rank)
+        {
+            /* The last bucket has no upper end, max is the best estimate */
+            if (b == NFCTEST_HIST_BUCKETS - 1)
+            {
+                return stats->max_us;
+            }
+
+            uint32_t upper = (b == 0) ? 0 : (uint32_t)((1ull << b) - 1);
+
+            return CLAMP(upper, stats->min_us, stats->max_us);
+        }
+    }
+
+    return stats->max_us;
+}
+
+void nfctest_phase_stats_reset(void)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+    memset(m_phase_stats, 0, sizeof(m_phase_stats));
+    k_mutex_unlock(&nfc_lock);
+}
+
+int nfctest_abort(void)
+{
+    k_mutex_lock(&nfc_lock, K_FOREVER);
+
+    /* Nothing to cancel: posting anyway would leave a stale bit behind */
+    bool active = m_nfctest_running || m_swap_waiting;
+
+    if (active)
+    {
+        k_event_post(&nfc_events, NFC_EVT_CANCEL);
+    }
+
+    k_mutex_unlock(&nfc_lock);
+
+    return active ? 0 : -ENOENT;
+}
@@ -1,21 +1,160 @@
-#ifndef NFC_TEST_H
-#define NFC_TEST_H
-
-#include <stdint.h>
-
-#define MAX_REC_COUNT     1
-#define NDEF_MSG_BUF_SIZE 128
-#define NFCTEST_PAYLOAD_MAX 32
-#define NFCTEST_RW_TIMEOUT_DEFAULT_MS 5000
-
-/* Initializes the Type 4 Tag with callback */
-int nfctest_setup(void);
-
-/*
- * Test entry point
- * mode == 1 → send (read-only)
- * mode == 2 → receive (read/write)
- */
-int nfctest(int mode, uint8_t *data, size_t *data_length, uint32_t timeout_ms);
-
-#endif /* NFC_TEST_H */
+#ifndef NFC_TEST_H
+#define NFC_TEST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define MAX_REC_COUNT     1
+#define NDEF_MSG_BUF_SIZE 128
+#define NFCTEST_PAYLOAD_MAX 32
+#define NFCTEST_RW_TIMEOUT_DEFAULT_MS 5000
+#define NFCTEST_PAYLOAD_SLOTS 2     /* static payload buffers, one is served */
+#define NFCTEST_MSG_CACHE_SLOTS 16  /* pre-encoded messages, see nfctest_msg_cache_load() */
+#define NFCTEST_READ_LOG_LEN 16
+#define NFCTEST_EVENT_RING_LEN 32   /* callback to worker queue and trace, power of two */
+#define NFCTEST_EVENT_STACK_SIZE 1024
+#define NFCTEST_HIST_BUCKETS 24     /* log2 buckets of microseconds, the last one open */
+#define NFCTEST_SWAP_TIMEOUT_MS 1000
+
+enum nfctest_phase
+{
+    NFCTEST_PHASE_SETUP,        /* nfc_t4t_setup(), once per boot */
+    NFCTEST_PHASE_START,        /* nfc_t4t_emulation_start() */
+    NFCTEST_PHASE_FIELD_ON,     /* emulation start to the first FIELD_ON */
+    NFCTEST_PHASE_NDEF,         /* FIELD_ON to the first NDEF_READ or NDEF_UPDATED */
+    NFCTEST_PHASE_FIELD_OFF,    /* last NDEF_READ or NDEF_UPDATED to FIELD_OFF */
+    NFCTEST_PHASE_STOP,         /* nfc_t4t_emulation_stop() */
+    NFCTEST_PHASE_COUNT
+};
+
+/* Bucket 0 counts 0 us, bucket b > 0 counts [2^(b-1), 2^b) us */
+struct nfctest_phase_stats
+{
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[NFCTEST_HIST_BUCKETS];
+};
+
+/* A T4T library event as queued by the callback */
+struct nfctest_event
+{
+    uint32_t cycles;        /* k_cycle_get_32() in the callback */
+    uint32_t length;        /* data_length of the event */
+    uint8_t type;           /* nfc_t4t_event_t */
+};
+
+struct nfctest_read_record
+{
+    uint32_t seq;           /* 1 for the first read after start */
+    int64_t uptime_ms;
+};
+
+struct nfctest_persist_status
+{
+    bool active;
+    uint32_t taps;          /* FIELD_ON events */
+    uint32_t reads;         /* NDEF_READ events */
+    uint32_t swaps;         /* payload changes while running */
+    int64_t started_ms;
+};
+
+struct nfctest_msg_info
+{
+    uint32_t hash;          /* CRC-32/BZIP2 of the text */
+    uint32_t hits;          /* times served without encoding */
+    uint32_t encoded_len;   /* T4T NDEF file bytes */
+    size_t text_len;
+    uint8_t text[NFCTEST_PAYLOAD_MAX];
+    bool served;
+};
+
+/* Initializes the Type 4 Tag with callback */
+int nfctest_setup(void);
+
+/*
+ * Test entry point
+ * mode == 1 → send (read-only)
+ * mode == 2 → receive (read/write)
+ * Returns -EBUSY without touching the tag while another test holds the NFC
+ * path (a background job from nfctest_job_start() or another caller) or
+ * persistent emulation is serving, and -ECANCELED after nfctest_abort().
+ */
+int nfctest(int mode, uint8_t *data, size_t *data_length, uint32_t timeout_ms);
+
+/*
+ * Persistent read-only emulation: stays armed across any number of reader
+ * taps until nfctest_persist_stop(). One-shot nfctest() calls return -EBUSY
+ * while it runs.
+ */
+int nfctest_persist_start(const uint8_t *data, size_t data_length);
+
+/*
+ * Replace the payload without stopping emulation. The new message is encoded
+ * into a slot the reader is not served from, then made current once no
+ * reader is in the field and no T4T event is still queued. Waits up to
+ * NFCTEST_SWAP_TIMEOUT_MS for that, then returns -EBUSY and the old payload
+ * stays. If the library refuses the payload while emulating, emulation is
+ * restarted around the change.
+ */
+int nfctest_persist_update(const uint8_t *data, size_t data_length);
+
+int nfctest_persist_stop(void);
+
+void nfctest_persist_status_get(struct nfctest_persist_status *status);
+
+/* Copy up to max of the latest reads, oldest first. Returns the count */
+size_t nfctest_persist_reads_get(struct nfctest_read_record *records, size_t max);
+
+/*
+ * Encode a text message into a message cache slot. Mode 1 and the
+ * persistent emulation serve a cached message with the same text as is,
+ * and nfctest_msg_cache_select() serves it by slot. Loading the text a slot
+ * already holds costs only the hash. Returns -EBUSY for the slot being
+ * served by persistent emulation or a running mode 1 test.
+ */
+int nfctest_msg_cache_load(size_t slot, const uint8_t *data, size_t data_length);
+
+/*
+ * Serve a cached message: starts persistent emulation, or swaps the payload
+ * like nfctest_persist_update() when it is running. -ENOENT for empty slots.
+ */
+int nfctest_msg_cache_select(size_t slot);
+
+int nfctest_msg_cache_info_get(size_t slot, struct nfctest_msg_info *info);
+
+/* Empty all slots except the one being served. Returns the number cleared */
+size_t nfctest_msg_cache_clear(void);
+
+/*
+ * Cancel the running mode 1 or 2 test, which then returns -ECANCELED, and a
+ * payload swap waiting for the reader to leave. Returns -ENOENT, without
+ * touching either, when neither is in progress.
+ */
+int nfctest_abort(void);
+
+const char *nfctest_event_name(uint8_t type);
+
+/*
+ * Copy up to max of the latest handled events, oldest first, and the number
+ * of events dropped because the queue was full. Returns the count.
+ */
+size_t nfctest_trace_get(struct nfctest_event *events, size_t max, uint32_t *dropped);
+
+void nfctest_trace_clear(void);
+
+const char *nfctest_phase_name(enum nfctest_phase phase);
+
+void nfctest_phase_stats_get(enum nfctest_phase phase, struct nfctest_phase_stats *stats);
+
+/*
+ * Estimate a percentile from the histogram: the upper end of the bucket
+ * holding it, kept within min and max. Max for the open last bucket.
+ */
+uint32_t nfctest_phase_percentile(const struct nfctest_phase_stats *stats, unsigned int pct);
+
+void nfctest_phase_stats_reset(void);
+
+#endif /* NFC_TEST_H */
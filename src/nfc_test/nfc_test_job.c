@@ -0,0 +1,249 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include "nfc_test_job.h"
+
+LOG_MODULE_REGISTER(nfctest_job);
+
+BUILD_ASSERT(NFCTEST_JOB_SLOTS <= 32, "One nfc_job_done bit per slot");
+
+struct job_slot
+{
+    struct nfctest_job_info info;
+    int64_t queued_ms;
+    int64_t done_ms;
+    bool used;
+};
+
+K_MUTEX_DEFINE(nfc_job_lock);
+K_EVENT_DEFINE(nfc_job_done);
+K_MSGQ_DEFINE(nfc_job_queue, sizeof(uint32_t), NFCTEST_JOB_SLOTS, 4);
+K_THREAD_STACK_DEFINE(nfc_job_stack, NFCTEST_JOB_STACK_SIZE);
+
+static struct k_thread nfc_job_thread;
+static struct job_slot m_jobs[NFCTEST_JOB_SLOTS];
+static uint32_t m_next_id = 1;
+static bool m_started;
+
+/* Called with nfc_job_lock held */
+static struct job_slot *job_find(uint32_t id)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_jobs); i++)
+    {
+        if (m_jobs[i].used && m_jobs[i].info.id == id)
+        {
+            return &m_jobs[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Called with nfc_job_lock held */
+static void job_info_get(const struct job_slot *slot, struct nfctest_job_info *info)
+{
+    int64_t end = (slot->info.state == NFCTEST_JOB_DONE) ? slot->done_ms : k_uptime_get();
+
+    *info = slot->info;
+    info->elapsed_ms = (uint32_t)(end - slot->queued_ms);
+}
+
+static void nfc_job_runner(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    uint32_t id;
+
+    while (1)
+    {
+        k_msgq_get(&nfc_job_queue, &id, K_FOREVER);
+
+        k_mutex_lock(&nfc_job_lock, K_FOREVER);
+
+        struct job_slot *slot = job_find(id);
+
+        if (slot == NULL)
+        {
+            k_mutex_unlock(&nfc_job_lock);
+            continue;
+        }
+
+        struct nfctest_job_info job = slot->info;
+
+        slot->info.state = NFCTEST_JOB_RUNNING;
+        k_mutex_unlock(&nfc_job_lock);
+
+        /* The slot stays ours while RUNNING, only finished slots are reused */
+        int ret = nfctest(job.mode, job.data, &job.data_length, job.timeout_ms);
+
+        k_mutex_lock(&nfc_job_lock, K_FOREVER);
+
+        slot->info.result = ret;
+        slot->info.data_length = job.data_length;
+        memcpy(slot->info.data, job.data, sizeof(slot->info.data));
+        slot->info.state = NFCTEST_JOB_DONE;
+        slot->done_ms = k_uptime_get();
+
+        k_event_post(&nfc_job_done, BIT(slot - m_jobs));
+
+        k_mutex_unlock(&nfc_job_lock);
+
+        LOG_INF("NFC job %u done (%d)", id, ret);
+    }
+}
+
+int nfctest_job_start(int mode, const uint8_t *data, size_t data_length, uint32_t timeout_ms)
+{
+    struct job_slot *slot = NULL;
+
+    if ((mode != 1 && mode != 2) || data_length >= NFCTEST_PAYLOAD_MAX ||
+        (mode == 1 && (data == NULL || data_length == 0)))
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&nfc_job_lock, K_FOREVER);
+
+    if (!m_started)
+    {
+        k_thread_create(&nfc_job_thread, nfc_job_stack,
+                        K_THREAD_STACK_SIZEOF(nfc_job_stack),
+                        nfc_job_runner, NULL, NULL, NULL,
+                        K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+        k_thread_name_set(&nfc_job_thread, "nfctest_job");
+        m_started = true;
+    }
+
+    /* A free slot, else the oldest finished job */
+    for (size_t i = 0; i < ARRAY_SIZE(m_jobs); i++)
+    {
+        struct job_slot *s = &m_jobs[i];
+
+        if (!s->used)
+        {
+            slot = s;
+            break;
+        }
+
+        if (s->info.state == NFCTEST_JOB_DONE && (slot == NULL || s->info.id < slot->info.id))
+        {
+            slot = s;
+        }
+    }
+
+    if (slot == NULL)
+    {
+        k_mutex_unlock(&nfc_job_lock);
+        return -EBUSY;
+    }
+
+    *slot = (struct job_slot){
+        .info = {
+            .id = m_next_id++,
+            .state = NFCTEST_JOB_QUEUED,
+            .mode = mode,
+            .timeout_ms = timeout_ms,
+            .data_length = (mode == 1) ? data_length : 0,
+        },
+        .queued_ms = k_uptime_get(),
+        .used = true,
+    };
+
+    if (mode == 1)
+    {
+        memcpy(slot->info.data, data, data_length);
+    }
+
+    if (m_next_id > INT32_MAX)
+    {
+        m_next_id = 1;
+    }
+
+    k_event_clear(&nfc_job_done, BIT(slot - m_jobs));
+
+    /* Cannot be full: there is one entry per unfinished slot at most */
+    uint32_t id = slot->info.id;
+
+    k_msgq_put(&nfc_job_queue, &id, K_NO_WAIT);
+
+    k_mutex_unlock(&nfc_job_lock);
+
+    return (int)id;
+}
+
+int nfctest_job_status(uint32_t id, struct nfctest_job_info *info)
+{
+    k_mutex_lock(&nfc_job_lock, K_FOREVER);
+
+    struct job_slot *slot = job_find(id);
+
+    if (slot != NULL)
+    {
+        job_info_get(slot, info);
+    }
+
+    k_mutex_unlock(&nfc_job_lock);
+
+    return (slot != NULL) ? 0 : -ENOENT;
+}
+
+size_t nfctest_job_list(struct nfctest_job_info *infos, size_t max)
+{
+    size_t count = 0;
+
+    k_mutex_lock(&nfc_job_lock, K_FOREVER);
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_jobs) && count < max; i++)
+    {
+        if (!m_jobs[i].used)
+        {
+            continue;
+        }
+
+        /* Insertion sort by ID, there are only a few slots */
+        size_t pos = count++;
+
+        while (pos > 0 && infos[pos - 1].id > m_jobs[i].info.id)
+        {
+            infos[pos] = infos[pos - 1];
+            pos--;
+        }
+
+        job_info_get(&m_jobs[i], &infos[pos]);
+    }
+
+    k_mutex_unlock(&nfc_job_lock);
+
+    return count;
+}
+
+int nfctest_job_wait(uint32_t id, uint32_t timeout_ms, struct nfctest_job_info *info)
+{
+    k_mutex_lock(&nfc_job_lock, K_FOREVER);
+
+    struct job_slot *slot = job_find(id);
+
+    if (slot == NULL)
+    {
+        k_mutex_unlock(&nfc_job_lock);
+        return -ENOENT;
+    }
+
+    uint32_t bit = BIT(slot - m_jobs);
+
+    k_mutex_unlock(&nfc_job_lock);
+
+    /* The bit is cleared only when the slot is reused for a newer job */
+    k_event_wait(&nfc_job_done, bit, false, K_MSEC(timeout_ms));
+
+    int err = nfctest_job_status(id, info);
+
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return (info->state == NFCTEST_JOB_DONE) ? 0 : -EAGAIN;
+}
@@ -0,0 +1,50 @@
+#ifndef NFC_TEST_JOB_H
+#define NFC_TEST_JOB_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "nfc_test.h"
+
+#define NFCTEST_JOB_SLOTS      4       /* queued, running and finished jobs kept */
+#define NFCTEST_JOB_STACK_SIZE 2048
+
+enum nfctest_job_state
+{
+    NFCTEST_JOB_QUEUED,
+    NFCTEST_JOB_RUNNING,
+    NFCTEST_JOB_DONE
+};
+
+struct nfctest_job_info
+{
+    uint32_t id;
+    enum nfctest_job_state state;
+    int mode;
+    int result;                     /* nfctest() return value once done */
+    uint32_t timeout_ms;
+    uint32_t elapsed_ms;            /* queued to done, or so far */
+    size_t data_length;
+    uint8_t data[NFCTEST_PAYLOAD_MAX];  /* mode 1 payload, or the text received in mode 2 */
+};
+
+/*
+ * Queue an nfctest() run of mode 1 or 2 on the job thread and return its
+ * ID (> 0) without waiting. Jobs run one at a time in order. -EBUSY when
+ * every slot holds an unfinished job; finished jobs are forgotten oldest
+ * first to make room.
+ */
+int nfctest_job_start(int mode, const uint8_t *data, size_t data_length, uint32_t timeout_ms);
+
+/* -ENOENT for IDs no longer kept */
+int nfctest_job_status(uint32_t id, struct nfctest_job_info *info);
+
+/* Copy up to max of the kept jobs, oldest first. Returns the count */
+size_t nfctest_job_list(struct nfctest_job_info *infos, size_t max);
+
+/*
+ * Wait up to timeout_ms for a job to finish, then report it like
+ * nfctest_job_status(). -EAGAIN if it is still queued or running.
+ */
+int nfctest_job_wait(uint32_t id, uint32_t timeout_ms, struct nfctest_job_info *info);
+
+#endif /* NFC_TEST_JOB_H */
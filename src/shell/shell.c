@@ -1,269 +1,2010 @@
-#include <zephyr/shell/shell.h>
-#include <zephyr/drivers/uart.h>
-#include <stdlib.h>
-#include "nfc_test.h"
-#include "crc32_test.h"
-#include "nfc_test_field_detect.h"
-
-#define NFCTEST_FIELD_TIMEOUT_DEFAULT_MS 1000
-
-typedef enum 
-{
-    NFC_TEST_MODE_INVALID = -1,
-    NFC_TEST_MODE_READ    = 1,
-    NFC_TEST_MODE_WRITE   = 2,
-    NFC_TEST_MODE_SENSE   = 3,
-    NFC_TEST_MODE_FIELD   = 4,
-} nfc_test_mode_t;
-
-int cmd_nfctest(const struct shell *sh, size_t argc, char **argv)
-{
-    nfc_test_mode_t mode = NFC_TEST_MODE_INVALID;
-    int ret = 0;
-    bool run_nfctest = true;
-    uint32_t timeout_ms = NFCTEST_RW_TIMEOUT_DEFAULT_MS;
-
-    uint8_t ndef_text_buf[NFCTEST_PAYLOAD_MAX] = {0};
-    size_t ndef_text_len = 0;
-
-    if (argc < 2)
-    {
-        shell_print(sh, "Usage: nfctest <mode> [args]");
-        shell_print(sh, "  mode 1: set <payload> as tag value");
-        shell_print(sh, "  mode 2: set empty tag, wait for write");
-        shell_print(sh, "  mode 3: NFCT sense on/off");
-        shell_print(sh, "  mode 4: field presence test");
-        return -EINVAL;
-    }
-
-    if (strcmp(argv[1], "1") == 0)
-        mode = 1;
-    else if (strcmp(argv[1], "2") == 0)
-        mode = 2;
-    else if (strcmp(argv[1], "3") == 0)
-        mode = 3;
-    else if (strcmp(argv[1], "4") == 0)
-        mode = 4;
-    else
-    {
-        shell_print(sh, "Invalid mode, use 1–4");
-        return -EINVAL;
-    }
-
-    switch (mode)
-    {
-        case NFC_TEST_MODE_READ:
-
-            if (argc < 3)
-            {
-                shell_print(sh, "Missing text for mode 1");
-                return -EINVAL;
-            }
-
-            ndef_text_len = strlen(argv[2]);
-            if (ndef_text_len >= NFCTEST_PAYLOAD_MAX)
-            {
-                shell_print(sh, "Text too long (max %d)", NFCTEST_PAYLOAD_MAX - 1);
-                return -EINVAL;
-            }
-
-            memcpy(ndef_text_buf, argv[2], ndef_text_len);
-            ndef_text_buf[ndef_text_len] = '\0';
-
-            if (argc >= 4) 
-            {
-                char *endptr;
-                unsigned long val = strtoul(argv[3], &endptr, 10);
-
-                if (*endptr != '\0' || val == 0) 
-                {
-                    shell_print(sh, "Invalid timeout value");
-                    return -EINVAL;
-                }
-
-                timeout_ms = (uint32_t)val;
-            }
-
-            shell_print(sh, "NFC text set to: %s", ndef_text_buf);
-            break;
-
-        case NFC_TEST_MODE_WRITE:
-
-            if (argc >= 3) 
-            {
-                char *endptr;
-                unsigned long val = strtoul(argv[2], &endptr, 10);
-
-                if (*endptr != '\0' || val == 0) 
-                {
-                    shell_print(sh, "Invalid timeout value");
-                    return -EINVAL;
-                }
-
-                timeout_ms = (uint32_t)val;
-            }
-
-            shell_print(sh,
-                "NFC write mode (timeout %u ms)",
-                timeout_ms);
-            break;
-
-        case NFC_TEST_MODE_SENSE:
-        {
-            int submode;
-
-            if (argc < 3)
-            {
-                shell_print(sh, "Usage: nfctest 3 <submode>");
-                shell_print(sh, "  submode 1 = Sense ON");
-                shell_print(sh, "  submode 2 = Sense OFF");
-                return -EINVAL;
-            }
-
-            if (strcmp(argv[2], "1") == 0)
-                submode = 1;
-            else if (strcmp(argv[2], "2") == 0)
-                submode = 2;
-            else
-            {
-                shell_print(sh, "Invalid submode, use 1 or 2");
-                return -EINVAL;
-            }
-
-            shell_print(sh,
-                "Starting NFC test mode 3, submode %d",
-                submode);
-
-            ret = nfct_sense_on_off(submode);
-
-            shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
-
-            run_nfctest = false;
-            break;
-        }
-
-        case NFC_TEST_MODE_FIELD:
-        {
-            struct nfct_field_info info;
-
-            uint32_t field_timeout_ms = NFCTEST_FIELD_TIMEOUT_DEFAULT_MS;
-
-
-            if (argc >= 3) 
-            {
-                char *endptr;
-                unsigned long val = strtoul(argv[2], &endptr, 10);
-
-                if (*endptr != '\0' || val == 0) 
-                {
-                    shell_print(sh, "Invalid timeout value");
-                    ret = -EINVAL;
-                    run_nfctest = false;
-                    break;
-                }
-
-                field_timeout_ms = (uint32_t)val;
-            }
-
-            shell_print(sh, "Starting NFC test mode 4");
-
-            ret = check_field_presence(field_timeout_ms, &info);
-
-            shell_print(sh, "check_field_presence ret=%d", ret);
-            shell_print(sh, "last_fp_seen = 0x%08X", info.last_fp_seen);
-            shell_print(sh, "FIELDPRESENT = 0x%08X", info.fieldpresent);
-            shell_print(sh, "NFCTAGSTATE  = 0x%08X", info.nfctagstate);
-            shell_print(sh, "FREQ RAW     = %u", info.freq_raw);
-            shell_print(sh, "FREQ (Hz)    = %u", info.freq_hz);
-
-            shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
-
-            run_nfctest = false;
-            break;
-        }
-
-        default:
-            return -EINVAL;
-    }
-
-    if (!run_nfctest) 
-    {
-        return ret;
-    }
-
-    shell_print(sh, "Starting NFC test mode %d", mode);
-
-    ret = nfctest(mode, ndef_text_buf, &ndef_text_len, timeout_ms);
-
-    if (ret == 0 && mode == NFC_TEST_MODE_WRITE)
-    {
-        shell_print(sh, "NFC RX TEXT: %s", ndef_text_buf);
-    }
-
-    shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
-    return ret;
-}
-
-SHELL_CMD_REGISTER(nfctest, NULL,
-                   "NFC test command",
-                   cmd_nfctest);
-
-static int cmd_crc32(const struct shell *sh, size_t argc, char **argv)
-{
-    uintptr_t address;
-    size_t words_len;
-    int mode;
-
-    if (argc < 4)
-    {
-        shell_print(sh, "Usage: crc32 <address> <words> <mode>");
-        return -1;
-    }
-
-    if (argv[2][0] == '-') 
-    {
-        shell_print(sh, "Word count must be positive");
-        return -EINVAL;
-    }
-
-    address   = strtoul(argv[1], NULL, 0);
-    words_len = strtoul(argv[2], NULL, 0);
-
-    if (strcmp(argv[3], "0") == 0)
-    {
-        mode = 0;
-    }
-    else if (strcmp(argv[3], "1") == 0)
-    {
-        mode = 1;
-    } 
-    else
-    {
-        shell_print(sh, "Invalid mode, use 0 or 1");
-        return -EINVAL;
-    }
-
-    struct crc_result r = crc32_words_check(address, words_len, mode);
-
-    if (r.status == CRC_INVALID) 
-    {
-        shell_print(sh, "Invalid parameters");
-        return -EINVAL;
-    }
-
-    if (mode == 0) 
-    {
-        shell_print(sh, "0x%08X", r.crc);
-        return 0;
-    }
-
-    shell_print(sh, "0x%08X 0x%08X %s",
-                r.crc, r.crc_ref,
-                (r.status == CRC_OK) ? "OK" : "FAIL");
-
-    return 0;
-}
-
-SHELL_CMD_REGISTER(crc32, NULL,
-                   "crc32 test command",
-                   cmd_crc32);
+#include <zephyr/shell/shell.h>
+#include <zephyr/drivers/uart.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "nfc_test.h"
+#include "crc32_test.h"
+#include "crc32_parallel.h"
+#include "crc32_engine.h"
+#include "crc32_manifest.h"
+#include "crc32_index.h"
+#include "crc32_scrub.h"
+#include "crc32_fused.h"
+#include "crc32_pipeline.h"
+#include "crc32_stream.h"
+#include "crc32_syndrome.h"
+#include "crc32_cache.h"
+#include "crc32_job.h"
+#include "nfc_test_field_detect.h"
+#include "nfc_test_job.h"
+
+#define NFCTEST_FIELD_TIMEOUT_DEFAULT_MS 1000
+#define CRC32_INDEX_SHELL_BLOCKS         1024
+#define CRC32_SEGMENTS_SHELL_MAX         8
+#define CRC32_JOB_SHELL_RESULTS          8
+
+typedef enum 
+{
+    NFC_TEST_MODE_INVALID = -1,
+    NFC_TEST_MODE_READ    = 1,
+    NFC_TEST_MODE_WRITE   = 2,
+    NFC_TEST_MODE_SENSE   = 3,
+    NFC_TEST_MODE_FIELD   = 4,
+} nfc_test_mode_t;
+
+int cmd_nfctest(const struct shell *sh, size_t argc, char **argv)
+{
+    nfc_test_mode_t mode = NFC_TEST_MODE_INVALID;
+    int ret = 0;
+    bool run_nfctest = true;
+    uint32_t timeout_ms = NFCTEST_RW_TIMEOUT_DEFAULT_MS;
+
+    uint8_t ndef_text_buf[NFCTEST_PAYLOAD_MAX] = {0};
+    size_t ndef_text_len = 0;
+
+    if (argc < 2)
+    {
+        shell_print(sh, "Usage: nfctest <mode> [args]");
+        shell_print(sh, "  mode 1: set <payload> as tag value");
+        shell_print(sh, "  mode 2: set empty tag, wait for write");
+        shell_print(sh, "  mode 3: NFCT sense on/off");
+        shell_print(sh, "  mode 4: field presence test");
+        shell_print(sh, "  serve: keep serving a payload, see nfctest serve");
+        shell_print(sh, "  msg: pre-encoded message slots, see nfctest msg");
+        return -EINVAL;
+    }
+
+    if (strcmp(argv[1], "1") == 0)
+        mode = 1;
+    else if (strcmp(argv[1], "2") == 0)
+        mode = 2;
+    else if (strcmp(argv[1], "3") == 0)
+        mode = 3;
+    else if (strcmp(argv[1], "4") == 0)
+        mode = 4;
+    else
+    {
+        shell_print(sh, "Invalid mode, use 1–4");
+        return -EINVAL;
+    }
+
+    switch (mode)
+    {
+        case NFC_TEST_MODE_READ:
+
+            if (argc < 3)
+            {
+                shell_print(sh, "Missing text for mode 1");
+                return -EINVAL;
+            }
+
+            ndef_text_len = strlen(argv[2]);
+            if (ndef_text_len >= NFCTEST_PAYLOAD_MAX)
+            {
+                shell_print(sh, "Text too long (max %d)", NFCTEST_PAYLOAD_MAX - 1);
+                return -EINVAL;
+            }
+
+            memcpy(ndef_text_buf, argv[2], ndef_text_len);
+            ndef_text_buf[ndef_text_len] = '\0';
+
+            if (argc >= 4) 
+            {
+                char *endptr;
+                unsigned long val = strtoul(argv[3], &endptr, 10);
+
+                if (*endptr != '\0' || val == 0) 
+                {
+                    shell_print(sh, "Invalid timeout value");
+                    return -EINVAL;
+                }
+
+                timeout_ms = (uint32_t)val;
+            }
+
+            shell_print(sh, "NFC text set to: %s", ndef_text_buf);
+            break;
+
+        case NFC_TEST_MODE_WRITE:
+
+            if (argc >= 3) 
+            {
+                char *endptr;
+                unsigned long val = strtoul(argv[2], &endptr, 10);
+
+                if (*endptr != '\0' || val == 0) 
+                {
+                    shell_print(sh, "Invalid timeout value");
+                    return -EINVAL;
+                }
+
+                timeout_ms = (uint32_t)val;
+            }
+
+            shell_print(sh,
+                "NFC write mode (timeout %u ms)",
+                timeout_ms);
+            break;
+
+        case NFC_TEST_MODE_SENSE:
+        {
+            int submode;
+
+            if (argc < 3)
+            {
+                shell_print(sh, "Usage: nfctest 3 <submode>");
+                shell_print(sh, "  submode 1 = Sense ON");
+                shell_print(sh, "  submode 2 = Sense OFF");
+                return -EINVAL;
+            }
+
+            if (strcmp(argv[2], "1") == 0)
+                submode = 1;
+            else if (strcmp(argv[2], "2") == 0)
+                submode = 2;
+            else
+            {
+                shell_print(sh, "Invalid submode, use 1 or 2");
+                return -EINVAL;
+            }
+
+            shell_print(sh,
+                "Starting NFC test mode 3, submode %d",
+                submode);
+
+            ret = nfct_sense_on_off(submode);
+
+            shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
+
+            run_nfctest = false;
+            break;
+        }
+
+        case NFC_TEST_MODE_FIELD:
+        {
+            struct nfct_field_info info;
+
+            uint32_t field_timeout_ms = NFCTEST_FIELD_TIMEOUT_DEFAULT_MS;
+
+
+            if (argc >= 3) 
+            {
+                char *endptr;
+                unsigned long val = strtoul(argv[2], &endptr, 10);
+
+                if (*endptr != '\0' || val == 0) 
+                {
+                    shell_print(sh, "Invalid timeout value");
+                    ret = -EINVAL;
+                    run_nfctest = false;
+                    break;
+                }
+
+                field_timeout_ms = (uint32_t)val;
+            }
+
+            shell_print(sh, "Starting NFC test mode 4");
+
+            ret = check_field_presence(field_timeout_ms, &info);
+
+            shell_print(sh, "check_field_presence ret=%d", ret);
+            shell_print(sh, "last_fp_seen = 0x%08X", info.last_fp_seen);
+            shell_print(sh, "FIELDPRESENT = 0x%08X", info.fieldpresent);
+            shell_print(sh, "NFCTAGSTATE  = 0x%08X", info.nfctagstate);
+            shell_print(sh, "FREQ RAW     = %u", info.freq_raw);
+            shell_print(sh, "FREQ (Hz)    = %u", info.freq_hz);
+
+            shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
+
+            run_nfctest = false;
+            break;
+        }
+
+        default:
+            return -EINVAL;
+    }
+
+    if (!run_nfctest) 
+    {
+        return ret;
+    }
+
+    shell_print(sh, "Starting NFC test mode %d", mode);
+
+    ret = nfctest(mode, ndef_text_buf, &ndef_text_len, timeout_ms);
+
+    if (ret == 0 && mode == NFC_TEST_MODE_WRITE)
+    {
+        shell_print(sh, "NFC RX TEXT: %s", ndef_text_buf);
+    }
+
+    shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
+    return ret;
+}
+
+static int nfctest_text_arg(const struct shell *sh, const char *arg, size_t *len)
+{
+    *len = strlen(arg);
+
+    if (*len == 0 || *len >= NFCTEST_PAYLOAD_MAX)
+    {
+        shell_print(sh, "Text must be 1-%d characters", NFCTEST_PAYLOAD_MAX - 1);
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+static int cmd_nfctest_serve_start(const struct shell *sh, size_t argc, char **argv)
+{
+    size_t len;
+    int ret = nfctest_text_arg(sh, argv[1], &len);
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    ret = nfctest_persist_start((const uint8_t *)argv[1], len);
+
+    if (ret < 0)
+    {
+        shell_print(sh, "FAIL (%d)", ret);
+        return ret;
+    }
+
+    shell_print(sh, "Serving \"%s\" until stopped", argv[1]);
+    return 0;
+}
+
+static int cmd_nfctest_serve_set(const struct shell *sh, size_t argc, char **argv)
+{
+    size_t len;
+    int ret = nfctest_text_arg(sh, argv[1], &len);
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    ret = nfctest_persist_update((const uint8_t *)argv[1], len);
+
+    if (ret == -EBUSY)
+    {
+        shell_print(sh, "Reader still in the field, payload unchanged");
+    }
+
+    shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
+    return ret;
+}
+
+static int cmd_nfctest_serve_stop(const struct shell *sh, size_t argc, char **argv)
+{
+    int ret = nfctest_persist_stop();
+
+    shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
+    return ret;
+}
+
+static int cmd_nfctest_serve_status(const struct shell *sh, size_t argc, char **argv)
+{
+    struct nfctest_persist_status st;
+    struct nfctest_read_record reads[NFCTEST_READ_LOG_LEN];
+
+    nfctest_persist_status_get(&st);
+
+    shell_print(sh, "%s, taps %u, reads %u, swaps %u",
+                st.active ? "Serving" : "Stopped", st.taps, st.reads, st.swaps);
+
+    size_t n = nfctest_persist_reads_get(reads, ARRAY_SIZE(reads));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        shell_print(sh, "  read %u at +%lld ms", reads[i].seq,
+                    (long long)(reads[i].uptime_ms - st.started_ms));
+    }
+
+    return 0;
+}
+
+static int nfctest_slot_arg(const struct shell *sh, const char *arg, size_t *slot)
+{
+    char *endptr;
+    unsigned long val = strtoul(arg, &endptr, 0);
+
+    if (*endptr != '\0' || val >= NFCTEST_MSG_CACHE_SLOTS)
+    {
+        shell_print(sh, "Invalid slot, use 0-%d", NFCTEST_MSG_CACHE_SLOTS - 1);
+        return -EINVAL;
+    }
+
+    *slot = val;
+    return 0;
+}
+
+static int cmd_nfctest_msg_load(const struct shell *sh, size_t argc, char **argv)
+{
+    size_t slot;
+    int ret = nfctest_slot_arg(sh, argv[1], &slot);
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    if (slot + (argc - 2) > NFCTEST_MSG_CACHE_SLOTS)
+    {
+        shell_print(sh, "Only %d slots", NFCTEST_MSG_CACHE_SLOTS);
+        return -EINVAL;
+    }
+
+    /* Consecutive texts go to consecutive slots */
+    for (size_t i = 2; i < argc; i++, slot++)
+    {
+        size_t len;
+
+        ret = nfctest_text_arg(sh, argv[i], &len);
+        if (ret == 0)
+        {
+            ret = nfctest_msg_cache_load(slot, (const uint8_t *)argv[i], len);
+        }
+
+        if (ret < 0)
+        {
+            shell_print(sh, "Slot %u: FAIL (%d)", (unsigned int)slot, ret);
+            return ret;
+        }
+    }
+
+    shell_print(sh, "OK");
+    return 0;
+}
+
+static int cmd_nfctest_msg_select(const struct shell *sh, size_t argc, char **argv)
+{
+    size_t slot;
+    int ret = nfctest_slot_arg(sh, argv[1], &slot);
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    ret = nfctest_msg_cache_select(slot);
+
+    if (ret == -EBUSY)
+    {
+        shell_print(sh, "Reader still in the field or another test running");
+    }
+
+    shell_print(sh, ret ? "FAIL (%d)" : "OK", ret);
+    return ret;
+}
+
+static int cmd_nfctest_msg_list(const struct shell *sh, size_t argc, char **argv)
+{
+    struct nfctest_msg_info info;
+    size_t used = 0;
+
+    for (size_t i = 0; i < NFCTEST_MSG_CACHE_SLOTS; i++)
+    {
+        if (nfctest_msg_cache_info_get(i, &info) < 0)
+        {
+            continue;
+        }
+
+        shell_print(sh, "%2u%s hash 0x%08X, %u bytes, %u hits: %s", (unsigned int)i,
+                    info.served ? "*" : " ", info.hash, info.encoded_len, info.hits,
+                    info.text);
+        used++;
+    }
+
+    shell_print(sh, "%u of %d slots used", (unsigned int)used, NFCTEST_MSG_CACHE_SLOTS);
+    return 0;
+}
+
+static int cmd_nfctest_msg_clear(const struct shell *sh, size_t argc, char **argv)
+{
+    shell_print(sh, "%u slots cleared", (unsigned int)nfctest_msg_cache_clear());
+    return 0;
+}
+
+static int nfctest_ms_arg(const struct shell *sh, const char *arg, uint32_t *ms)
+{
+    char *endptr;
+    unsigned long val = strtoul(arg, &endptr, 10);
+
+    if (*endptr != '\0' || val == 0)
+    {
+        shell_print(sh, "Invalid timeout value");
+        return -EINVAL;
+    }
+
+    *ms = (uint32_t)val;
+    return 0;
+}
+
+static int nfctest_id_arg(const struct shell *sh, const char *arg, uint32_t *id)
+{
+    char *endptr;
+    unsigned long val = strtoul(arg, &endptr, 10);
+
+    if (*endptr != '\0' || val == 0)
+    {
+        shell_print(sh, "Invalid job ID");
+        return -EINVAL;
+    }
+
+    *id = (uint32_t)val;
+    return 0;
+}
+
+static const char *nfctest_job_state_name(enum nfctest_job_state state)
+{
+    switch (state)
+    {
+        case NFCTEST_JOB_QUEUED:
+            return "queued";
+
+        case NFCTEST_JOB_RUNNING:
+            return "running";
+
+        default:
+            return "done";
+    }
+}
+
+static void nfctest_job_print(const struct shell *sh, const struct nfctest_job_info *info)
+{
+    if (info->state != NFCTEST_JOB_DONE)
+    {
+        shell_print(sh, "Job %u: mode %d, %s for %u ms", info->id, info->mode,
+                    nfctest_job_state_name(info->state), info->elapsed_ms);
+        return;
+    }
+
+    shell_print(sh, "Job %u: mode %d, done in %u ms, %s (%d)", info->id, info->mode,
+                info->elapsed_ms, info->result ? "FAIL" : "OK", info->result);
+}
+
+static int cmd_nfctest_start(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t timeout_ms = NFCTEST_RW_TIMEOUT_DEFAULT_MS;
+    const char *text = NULL;
+    size_t len = 0;
+    size_t next = 2;
+    int mode;
+    int ret;
+
+    if (strcmp(argv[1], "1") == 0)
+    {
+        mode = 1;
+    }
+    else if (strcmp(argv[1], "2") == 0)
+    {
+        mode = 2;
+    }
+    else
+    {
+        shell_print(sh, "Only modes 1 and 2 run as jobs");
+        return -EINVAL;
+    }
+
+    if (mode == 1)
+    {
+        if (argc < 3)
+        {
+            shell_print(sh, "Missing text for mode 1");
+            return -EINVAL;
+        }
+
+        text = argv[2];
+        ret = nfctest_text_arg(sh, text, &len);
+        if (ret < 0)
+        {
+            return ret;
+        }
+
+        next = 3;
+    }
+
+    if (argc > next + 1)
+    {
+        shell_print(sh, "Usage: nfctest start 1 <text> [timeout_ms] | 2 [timeout_ms]");
+        return -EINVAL;
+    }
+
+    if (argc == next + 1)
+    {
+        ret = nfctest_ms_arg(sh, argv[next], &timeout_ms);
+        if (ret < 0)
+        {
+            return ret;
+        }
+    }
+
+    ret = nfctest_job_start(mode, (const uint8_t *)text, len, timeout_ms);
+
+    if (ret < 0)
+    {
+        shell_print(sh, "FAIL (%d)", ret);
+        return ret;
+    }
+
+    shell_print(sh, "Job %d started", ret);
+    return 0;
+}
+
+static int cmd_nfctest_status(const struct shell *sh, size_t argc, char **argv)
+{
+    struct nfctest_job_info info;
+    uint32_t id;
+    int ret;
+
+    if (argc == 2)
+    {
+        ret = nfctest_id_arg(sh, argv[1], &id);
+        if (ret == 0)
+        {
+            ret = nfctest_job_status(id, &info);
+        }
+
+        if (ret == 0)
+        {
+            nfctest_job_print(sh, &info);
+        }
+        else if (ret == -ENOENT)
+        {
+            shell_print(sh, "Unknown job");
+        }
+
+        return ret;
+    }
+
+    struct nfctest_job_info jobs[NFCTEST_JOB_SLOTS];
+    size_t n = nfctest_job_list(jobs, ARRAY_SIZE(jobs));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        nfctest_job_print(sh, &jobs[i]);
+    }
+
+    if (n == 0)
+    {
+        shell_print(sh, "No jobs");
+    }
+
+    return 0;
+}
+
+static int cmd_nfctest_wait(const struct shell *sh, size_t argc, char **argv)
+{
+    struct nfctest_job_info info;
+    uint32_t timeout_ms = NFCTEST_RW_TIMEOUT_DEFAULT_MS;
+    uint32_t id;
+    int ret = nfctest_id_arg(sh, argv[1], &id);
+
+    if (ret == 0 && argc == 3)
+    {
+        ret = nfctest_ms_arg(sh, argv[2], &timeout_ms);
+    }
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    ret = nfctest_job_wait(id, timeout_ms, &info);
+
+    if (ret == -ENOENT)
+    {
+        shell_print(sh, "Unknown job");
+        return ret;
+    }
+
+    nfctest_job_print(sh, &info);
+
+    return (ret == 0) ? info.result : ret;
+}
+
+static int cmd_nfctest_result(const struct shell *sh, size_t argc, char **argv)
+{
+    struct nfctest_job_info info;
+    uint32_t id;
+    int ret = nfctest_id_arg(sh, argv[1], &id);
+
+    if (ret == 0)
+    {
+        ret = nfctest_job_status(id, &info);
+    }
+
+    if (ret == -ENOENT)
+    {
+        shell_print(sh, "Unknown job");
+    }
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    nfctest_job_print(sh, &info);
+
+    if (info.state != NFCTEST_JOB_DONE)
+    {
+        return -EAGAIN;
+    }
+
+    if (info.result == 0 && info.mode == 2)
+    {
+        shell_print(sh, "NFC RX TEXT: %s", info.data);
+    }
+
+    return info.result;
+}
+
+static int cmd_nfctest_abort(const struct shell *sh, size_t argc, char **argv)
+{
+    int ret = nfctest_abort();
+
+    shell_print(sh, ret ? "No NFC test running" : "NFC test cancelled");
+    return ret;
+}
+
+static int cmd_nfctest_trace(const struct shell *sh, size_t argc, char **argv)
+{
+    struct nfctest_event events[NFCTEST_EVENT_RING_LEN];
+    uint32_t dropped;
+
+    if (argc == 2 && strcmp(argv[1], "-c") != 0)
+    {
+        shell_print(sh, "Usage: nfctest trace [-c]");
+        return -EINVAL;
+    }
+
+    size_t n = nfctest_trace_get(events, ARRAY_SIZE(events), &dropped);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t delta_us =
+            (i == 0) ? 0 : k_cyc_to_us_floor32(events[i].cycles - events[i - 1].cycles);
+
+        shell_print(sh, "%-12s len %-4u +%u us", nfctest_event_name(events[i].type),
+                    events[i].length, delta_us);
+    }
+
+    shell_print(sh, "%u events, %u dropped", (unsigned int)n, dropped);
+
+    if (argc == 2)
+    {
+        nfctest_trace_clear();
+    }
+
+    return 0;
+}
+
+static int cmd_nfctest_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    struct nfctest_phase_stats st;
+
+    if (argc == 2 && strcmp(argv[1], "-r") != 0)
+    {
+        shell_print(sh, "Usage: nfctest stats [-r]");
+        return -EINVAL;
+    }
+
+    shell_print(sh, "%-10s %6s %9s %9s %9s %9s %9s", "phase", "count", "min us", "p50 us",
+                "p99 us", "max us", "avg us");
+
+    for (int p = 0; p < NFCTEST_PHASE_COUNT; p++)
+    {
+        nfctest_phase_stats_get(p, &st);
+
+        if (st.count == 0)
+        {
+            shell_print(sh, "%-10s %6u", nfctest_phase_name(p), 0u);
+            continue;
+        }
+
+        shell_print(sh, "%-10s %6u %9u %9u %9u %9u %9u", nfctest_phase_name(p), st.count,
+                    st.min_us, nfctest_phase_percentile(&st, 50),
+                    nfctest_phase_percentile(&st, 99), st.max_us,
+                    (uint32_t)(st.sum_us / st.count));
+    }
+
+    /*
+    * Histogram rows list the non-empty buckets as <upper bound us>:<count>,
+    * the open last one as >=<lower bound us>:<count>
+    */
+    for (int p = 0; p < NFCTEST_PHASE_COUNT; p++)
+    {
+        char line[160];
+        int pos = 0;
+
+        nfctest_phase_stats_get(p, &st);
+
+        for (size_t b = 0; b < NFCTEST_HIST_BUCKETS && pos < (int)sizeof(line); b++)
+        {
+            if (st.buckets[b] == 0)
+            {
+                continue;
+            }
+
+            if (b == NFCTEST_HIST_BUCKETS - 1)
+            {
+                pos += snprintf(&line[pos], sizeof(line) - pos, " >=%u:%u",
+                                (unsigned int)(1u << (b - 1)), st.buckets[b]);
+            }
+            else
+            {
+                pos += snprintf(&line[pos], sizeof(line) - pos, " <%u:%u",
+                                (unsigned int)(1u << b), st.buckets[b]);
+            }
+        }
+
+        if (pos > 0)
+        {
+            shell_print(sh, "%-10s%s", nfctest_phase_name(p), line);
+        }
+    }
+
+    if (argc == 2)
+    {
+        nfctest_phase_stats_reset();
+        shell_print(sh, "Statistics reset");
+    }
+
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_nfctest_msg,
+    SHELL_CMD_ARG(load, NULL, "Pre-encode texts from a slot on: load <slot> <text> [<text> ...]",
+                  cmd_nfctest_msg_load, 3, NFCTEST_MSG_CACHE_SLOTS - 1),
+    SHELL_CMD_ARG(select, NULL, "Serve a cached message: select <slot>",
+                  cmd_nfctest_msg_select, 2, 0),
+    SHELL_CMD_ARG(list, NULL, "Show cached messages, * is served", cmd_nfctest_msg_list, 1, 0),
+    SHELL_CMD_ARG(clear, NULL, "Empty the slots not being served", cmd_nfctest_msg_clear, 1, 0),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_nfctest_serve,
+    SHELL_CMD_ARG(start, NULL, "Serve <text> to every reader: start <text>",
+                  cmd_nfctest_serve_start, 2, 0),
+    SHELL_CMD_ARG(set, NULL, "Swap the served text: set <text>", cmd_nfctest_serve_set, 2, 0),
+    SHELL_CMD_ARG(stop, NULL, "Stop serving", cmd_nfctest_serve_stop, 1, 0),
+    SHELL_CMD_ARG(status, NULL, "Read count and latest read times", cmd_nfctest_serve_status,
+                  1, 0),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_nfctest,
+    SHELL_CMD(serve, &sub_nfctest_serve,
+              "Persistent read-only emulation: serve start|set|stop|status", NULL),
+    SHELL_CMD(msg, &sub_nfctest_msg,
+              "Pre-encoded message cache: msg load|select|list|clear", NULL),
+    SHELL_CMD_ARG(start, NULL,
+                  "Run mode 1 or 2 in the background: start 1 <text> [timeout_ms] | "
+                  "2 [timeout_ms]", cmd_nfctest_start, 2, 2),
+    SHELL_CMD_ARG(status, NULL, "State of a job, or of all kept jobs: status [<id>]",
+                  cmd_nfctest_status, 1, 1),
+    SHELL_CMD_ARG(wait, NULL, "Wait for a job to finish: wait <id> [timeout_ms]",
+                  cmd_nfctest_wait, 2, 1),
+    SHELL_CMD_ARG(result, NULL, "Outcome of a finished job: result <id>", cmd_nfctest_result,
+                  2, 0),
+    SHELL_CMD_ARG(abort, NULL, "Cancel the running mode 1 or 2 test", cmd_nfctest_abort, 1, 0),
+    SHELL_CMD_ARG(stats, NULL,
+                  "Per-phase latency histograms, -r resets; setup runs once per boot: "
+                  "stats [-r]",
+                  cmd_nfctest_stats, 1, 1),
+    SHELL_CMD_ARG(trace, NULL, "Latest T4T events and time since the previous one, -c clears: "
+                  "trace [-c]", cmd_nfctest_trace, 1, 1),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(nfctest, &sub_nfctest,
+                   "NFC test command",
+                   cmd_nfctest);
+
+static int crc32_num_arg(const struct shell *sh, const char *arg, const char *what,
+                         unsigned long *val)
+{
+    char *endptr;
+
+    *val = strtoul(arg, &endptr, 0);
+
+    if (arg[0] == '-' || endptr == arg || *endptr != '\0')
+    {
+        shell_print(sh, "Invalid %s: %s", what, arg);
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+/* "<address> <words> [<mode>]" from argv[1..3], mode NULL takes no mode */
+static int crc32_region_arg(const struct shell *sh, char **argv, uint32_t *address,
+                            size_t *words_len, int *mode)
+{
+    unsigned long val;
+
+    if (crc32_num_arg(sh, argv[1], "address", &val) < 0)
+    {
+        return -EINVAL;
+    }
+
+    *address = (uint32_t)val;
+
+    if (crc32_num_arg(sh, argv[2], "word count", &val) < 0)
+    {
+        return -EINVAL;
+    }
+
+    *words_len = val;
+
+    if (mode == NULL)
+    {
+        return 0;
+    }
+
+    if (strcmp(argv[3], "0") == 0)
+    {
+        *mode = 0;
+    }
+    else if (strcmp(argv[3], "1") == 0)
+    {
+        *mode = 1;
+    }
+    else
+    {
+        shell_print(sh, "Invalid mode, use 0 or 1");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+static int cmd_crc32(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t address;
+    size_t words_len;
+    int mode;
+    enum crc_kernel kernel = CRC_KERNEL_DEFAULT;
+    bool show_time = false;
+    bool bytes = false;
+    unsigned long slices = 0;
+
+    if (argc < 4)
+    {
+        shell_print(sh, "Usage: crc32 <address> <words> <mode> [-k <kernel>] [-p <slices>] [-b] [-t]");
+        shell_print(sh, "  -k: CRC kernel (byte, slice8, forward, clmul), default %s",
+                    crc32_kernel_name(CRC_KERNEL_DEFAULT));
+        shell_print(sh, "  -p: split into slices hashed on %d worker threads (max %d)",
+                    CRC32_PARALLEL_THREADS, CRC32_PARALLEL_SLICES_MAX);
+        shell_print(sh, "  -b: <words> is a byte count, address and length need no alignment");
+        shell_print(sh, "  -t: print elapsed cycles");
+        return -1;
+    }
+
+    if (crc32_region_arg(sh, argv, &address, &words_len, &mode) < 0)
+    {
+        return -EINVAL;
+    }
+
+    for (size_t i = 4; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-k") == 0 && (i + 1) < argc)
+        {
+            int err = crc32_kernel_from_name(argv[++i], &kernel);
+
+            if (err == -ENOTSUP)
+            {
+                shell_print(sh, "Kernel not built: %s", argv[i]);
+                return err;
+            }
+
+            if (err < 0)
+            {
+                shell_print(sh, "Unknown kernel: %s", argv[i]);
+                return err;
+            }
+        }
+        else if (strcmp(argv[i], "-p") == 0 && (i + 1) < argc)
+        {
+            char *endptr;
+
+            slices = strtoul(argv[++i], &endptr, 0);
+            if (*endptr != '\0' || slices == 0 || slices > CRC32_PARALLEL_SLICES_MAX)
+            {
+                shell_print(sh, "Invalid slice count");
+                return -EINVAL;
+            }
+        }
+        else if (strcmp(argv[i], "-b") == 0)
+        {
+            bytes = true;
+        }
+        else if (strcmp(argv[i], "-t") == 0)
+        {
+            show_time = true;
+        }
+        else
+        {
+            shell_print(sh, "Unknown option: %s", argv[i]);
+            return -EINVAL;
+        }
+    }
+
+    if (bytes && slices > 0)
+    {
+        shell_print(sh, "-b and -p cannot be combined");
+        return -EINVAL;
+    }
+
+    uint32_t start = k_cycle_get_32();
+    struct crc_result r;
+
+    if (bytes)
+    {
+        r = crc32_bytes_check_kernel(address, words_len, mode, kernel);
+    }
+    else if (slices > 0)
+    {
+        r = crc32_words_check_parallel(address, words_len, mode, slices, kernel);
+    }
+    else
+    {
+        r = crc32_words_check_kernel(address, words_len, mode, kernel);
+    }
+
+    uint32_t cycles = k_cycle_get_32() - start;
+
+    if (r.status == CRC_INVALID) 
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    if (mode == 0) 
+    {
+        shell_print(sh, "0x%08X", r.crc);
+    }
+    else
+    {
+        shell_print(sh, "0x%08X 0x%08X %s",
+                    r.crc, r.crc_ref,
+                    (r.status == CRC_OK) ? "OK" : "FAIL");
+    }
+
+    if (show_time)
+    {
+        shell_print(sh, "kernel %s: %u cycles (%u us)",
+                    crc32_kernel_name(kernel), cycles,
+                    (uint32_t)k_cyc_to_us_floor64(cycles));
+    }
+
+    return 0;
+}
+
+static int cmd_crc32_bench(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t address;
+    size_t words_len;
+    unsigned long iterations = 1;
+
+    if (crc32_region_arg(sh, argv, &address, &words_len, NULL) < 0)
+    {
+        return -EINVAL;
+    }
+
+    if (argc >= 4)
+    {
+        char *endptr;
+
+        iterations = strtoul(argv[3], &endptr, 0);
+        if (*endptr != '\0' || iterations == 0)
+        {
+            shell_print(sh, "Invalid iteration count");
+            return -EINVAL;
+        }
+    }
+
+    if (!crc32_words_valid(address, words_len))
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    const uint32_t *data = (const uint32_t *)address;
+    uint64_t bytes = (uint64_t)words_len * sizeof(uint32_t) * iterations;
+
+    /* slice8 and forward only slice with the slicing tier's tables */
+    shell_print(sh, "tier: %s", crc32_tier_name());
+    shell_print(sh, "kernel    crc         cycles      cyc/B    MB/s");
+
+    for (int k = 0; k < CRC_KERNEL_COUNT; k++)
+    {
+        if (!crc32_kernel_built((enum crc_kernel)k))
+        {
+            continue;
+        }
+
+        uint32_t crc = 0;
+        uint32_t start = k_cycle_get_32();
+
+        for (unsigned long i = 0; i < iterations; i++)
+        {
+            crc = crc32_bzip2_words_kernel(data, words_len, (enum crc_kernel)k);
+        }
+
+        uint32_t cycles = MAX(k_cycle_get_32() - start, 1u);
+        uint32_t cpb_x100 = (uint32_t)(((uint64_t)cycles * 100) / bytes);
+        uint32_t mbps = (uint32_t)((bytes * sys_clock_hw_cycles_per_sec()) /
+                                   ((uint64_t)cycles * 1000000));
+
+        shell_print(sh, "%-8s  0x%08X  %10u  %3u.%02u  %6u",
+                    crc32_kernel_name((enum crc_kernel)k), crc, cycles,
+                    cpb_x100 / 100, cpb_x100 % 100, mbps);
+    }
+
+    return 0;
+}
+
+static int cmd_crc32_variant(const struct shell *sh, size_t argc, char **argv)
+{
+    const struct crc32_variant *v;
+    uintptr_t address;
+    size_t len;
+
+    if (argc < 4)
+    {
+        shell_print(sh, "Usage: crc32 variant <name> <address> <bytes>");
+
+        for (size_t i = 0; (v = crc32_variant_get(i)) != NULL; i++)
+        {
+            shell_print(sh, "  %-8s poly 0x%08X init 0x%08X xorout 0x%08X%s",
+                        v->name, v->poly, v->init, v->xorout,
+                        v->reflected ? " reflected" : "");
+        }
+
+        return -EINVAL;
+    }
+
+    v = crc32_variant_find(argv[1]);
+    if (v == NULL)
+    {
+        shell_print(sh, "Unknown variant: %s", argv[1]);
+        return -EINVAL;
+    }
+
+    if (argv[3][0] == '-') 
+    {
+        shell_print(sh, "Byte count must be positive");
+        return -EINVAL;
+    }
+
+    address = strtoul(argv[2], NULL, 0);
+    len     = strtoul(argv[3], NULL, 0);
+
+    if (len == 0)
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    uint32_t crc = crc32_engine_compute(v, (const void *)address, len);
+
+    shell_print(sh, "0x%08X", crc);
+
+    return 0;
+}
+
+#ifdef CONFIG_CRC32_FUSED
+static int cmd_crc32_digest(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t address;
+    size_t words_len;
+    unsigned int digests = 0;
+    bool show_time = false;
+
+    if (crc32_region_arg(sh, argv, &address, &words_len, NULL) < 0)
+    {
+        return -EINVAL;
+    }
+
+    for (size_t i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "bzip2") == 0)
+        {
+            digests |= CRC32_DIGEST_BZIP2;
+        }
+        else if (strcmp(argv[i], "crc32c") == 0)
+        {
+            digests |= CRC32_DIGEST_CRC32C;
+        }
+        else if (strcmp(argv[i], "sha256") == 0)
+        {
+            digests |= CRC32_DIGEST_SHA256;
+        }
+        else if (strcmp(argv[i], "-t") == 0)
+        {
+            show_time = true;
+        }
+        else
+        {
+            shell_print(sh, "Unknown digest: %s", argv[i]);
+            return -EINVAL;
+        }
+    }
+
+    if (digests == 0)
+    {
+        digests = CRC32_DIGEST_ALL;
+    }
+
+    uint32_t start = k_cycle_get_32();
+    struct crc_fused_result r = crc32_words_check_fused(address, words_len, 0, digests);
+    uint32_t cycles = k_cycle_get_32() - start;
+
+    if (r.status == CRC_INVALID)
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    if (r.digests & CRC32_DIGEST_BZIP2)
+    {
+        shell_print(sh, "bzip2  0x%08X", r.crc);
+    }
+
+    if (r.digests & CRC32_DIGEST_CRC32C)
+    {
+        shell_print(sh, "crc32c 0x%08X", r.crc32c);
+    }
+
+    if (r.digests & CRC32_DIGEST_SHA256)
+    {
+        char hex[SHA256_DIGEST_SIZE * 2 + 1];
+
+        for (size_t i = 0; i < SHA256_DIGEST_SIZE; i++)
+        {
+            snprintf(&hex[i * 2], 3, "%02x", r.sha256[i]);
+        }
+
+        shell_print(sh, "sha256 %s", hex);
+    }
+
+    if (show_time)
+    {
+        shell_print(sh, "%u cycles (%u us)", cycles, (uint32_t)k_cyc_to_us_floor64(cycles));
+    }
+
+    return 0;
+}
+#endif
+
+static int cmd_crc32_locate(const struct shell *sh, size_t argc, char **argv)
+{
+    struct crc32_error_location loc;
+    uint32_t address;
+    size_t words_len;
+    bool repair = false;
+
+    if (crc32_region_arg(sh, argv, &address, &words_len, NULL) < 0)
+    {
+        return -EINVAL;
+    }
+
+    if (argc >= 4)
+    {
+        if (strcmp(argv[3], "-r") != 0)
+        {
+            shell_print(sh, "Unknown option: %s", argv[3]);
+            return -EINVAL;
+        }
+
+        repair = true;
+    }
+
+    struct crc_result r = crc32_words_check_locate(address, words_len, repair, &loc);
+
+    if (r.status == CRC_INVALID)
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    switch (loc.kind)
+    {
+        case CRC32_ERROR_NONE:
+            shell_print(sh, "0x%08X OK", r.crc);
+            return 0;
+
+        case CRC32_ERROR_TRAILER:
+            shell_print(sh, "Stored CRC at 0x%08X bit %u flipped", loc.address[0], loc.bit[0]);
+            break;
+
+        case CRC32_ERROR_SINGLE:
+            shell_print(sh, "Single-bit error at 0x%08X bit %u", loc.address[0], loc.bit[0]);
+            break;
+
+        case CRC32_ERROR_DOUBLE:
+            shell_print(sh, "Double-bit error at 0x%08X bit %u and 0x%08X bit %u",
+                        loc.address[0], loc.bit[0], loc.address[1], loc.bit[1]);
+            break;
+
+        default:
+            shell_print(sh, "0x%08X 0x%08X FAIL, not a single or double-bit error",
+                        r.crc, r.crc_ref);
+            return 0;
+    }
+
+    if (repair)
+    {
+        shell_print(sh, "%s", loc.repaired ? "Repaired" : "Repair failed");
+    }
+
+    return 0;
+}
+
+static int cmd_crc32_segments(const struct shell *sh, size_t argc, char **argv)
+{
+    struct crc32_segment segs[CRC32_SEGMENTS_SHELL_MAX];
+    enum crc32_order order = CRC32_ORDER_FORWARD;
+    size_t count = 0;
+    uint32_t crc;
+
+    for (size_t i = 1; i < argc; i++)
+    {
+        char *end;
+
+        if (strcmp(argv[i], "-r") == 0)
+        {
+            order = CRC32_ORDER_REVERSE;
+            continue;
+        }
+
+        if (count == ARRAY_SIZE(segs))
+        {
+            shell_print(sh, "At most %d segments", CRC32_SEGMENTS_SHELL_MAX);
+            return -EINVAL;
+        }
+
+        segs[count].address = strtoul(argv[i], &end, 0);
+
+        if (*end != ':' || end[1] == '-' || end[1] == '\0')
+        {
+            shell_print(sh, "Invalid segment %s, use <address>:<bytes>", argv[i]);
+            return -EINVAL;
+        }
+
+        segs[count].len = strtoul(end + 1, NULL, 0);
+        count++;
+    }
+
+    if (count == 0)
+    {
+        shell_print(sh, "No segments given");
+        return -EINVAL;
+    }
+
+    if (crc32_segments(segs, count, order, &crc) != 0)
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    shell_print(sh, "0x%08X", crc);
+
+    return 0;
+}
+
+static int cmd_crc32_pipeline(const struct shell *sh, size_t argc, char **argv)
+{
+    struct crc32_pipeline_cfg cfg = {
+        .chunk_words = CRC32_PIPELINE_CHUNK_WORDS_DEFAULT,
+        .buffers = CRC32_PIPELINE_BUFFERS_DEFAULT,
+    };
+    struct crc32_pipeline_stats st;
+    uint32_t address;
+    size_t words_len;
+    int mode;
+
+    if (crc32_region_arg(sh, argv, &address, &words_len, &mode) < 0)
+    {
+        return -EINVAL;
+    }
+
+    if (argc >= 5)
+    {
+        unsigned long val;
+
+        if (crc32_num_arg(sh, argv[4], "chunk size", &val) < 0)
+        {
+            return -EINVAL;
+        }
+
+        cfg.chunk_words = val;
+    }
+
+    if (argc >= 6)
+    {
+        unsigned long val;
+
+        if (crc32_num_arg(sh, argv[5], "buffer count", &val) < 0)
+        {
+            return -EINVAL;
+        }
+
+        cfg.buffers = val;
+    }
+
+    struct crc_result r = crc32_words_check_pipeline(address, words_len, mode, &cfg, &st);
+
+    if (r.status == CRC_INVALID)
+    {
+        shell_print(sh, "Invalid parameters (2-%d buffers, chunk <= %d words / buffers, "
+                    "in whole cache lines)",
+                    CRC32_PIPELINE_BUFFERS_MAX, CRC32_PIPELINE_POOL_WORDS);
+        return -EINVAL;
+    }
+
+    if (mode == 0)
+    {
+        shell_print(sh, "0x%08X", r.crc);
+    }
+    else
+    {
+        shell_print(sh, "0x%08X 0x%08X %s",
+                    r.crc, r.crc_ref,
+                    (r.status == CRC_OK) ? "OK" : "FAIL");
+    }
+
+    shell_print(sh, "%s, %u chunks of %u words x %u buffers",
+                st.dma ? "DMA" : "memcpy worker", (unsigned int)st.chunks,
+                (unsigned int)cfg.chunk_words, cfg.buffers);
+    shell_print(sh, "total %u, crc %u, copy %u, wait %u cycles, %u%% overlap",
+                st.total_cycles, st.crc_cycles, st.copy_cycles, st.wait_cycles,
+                st.overlap_percent);
+
+    return 0;
+}
+
+static int cmd_crc32_manifest(const struct shell *sh, size_t argc, char **argv)
+{
+    const struct crc32_manifest_entry *entries;
+    struct crc32_manifest_report report;
+    size_t count;
+    bool verbose = false;
+    bool from_blob = false;
+    uint32_t address = 0;
+
+    for (size_t i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-v") == 0)
+        {
+            verbose = true;
+        }
+        else if (!from_blob)
+        {
+            address = strtoul(argv[i], NULL, 0);
+            from_blob = true;
+        }
+        else
+        {
+            shell_print(sh, "Usage: crc32 manifest [<blob address>] [-v]");
+            return -EINVAL;
+        }
+    }
+
+    if (from_blob)
+    {
+        if (crc32_manifest_from_blob(address, &entries, &count) < 0)
+        {
+            shell_print(sh, "No valid manifest at 0x%08X", address);
+            return -EINVAL;
+        }
+    }
+    else
+    {
+        entries = crc32_manifest_builtin(&count);
+        if (count == 0)
+        {
+            shell_print(sh, "No crc32-manifest devicetree node");
+            return -ENOENT;
+        }
+    }
+
+    if (crc32_manifest_verify(entries, count, &report) < 0)
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    if (verbose)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            bool ok = (report.pass[i / 32] & (1u << (i % 32))) != 0;
+
+            shell_print(sh, "%2u 0x%08X %8u %s", (unsigned int)i, entries[i].address,
+                        entries[i].words, ok ? "OK" : "FAIL");
+        }
+    }
+
+    /* Highest word first, so the bitmap reads as one hex number */
+    char bitmap[CRC32_MANIFEST_MAX / 4 + 1];
+    size_t pos = 0;
+
+    bitmap[0] = '\0';
+
+    for (size_t w = DIV_ROUND_UP(count, 32); w > 0; w--)
+    {
+        pos += snprintf(&bitmap[pos], sizeof(bitmap) - pos, "%08X", report.pass[w - 1]);
+    }
+
+    shell_print(sh, "%u/%u OK, bitmap 0x%s, %u cycles (%u us)",
+                (unsigned int)report.passed, (unsigned int)report.count, bitmap,
+                report.cycles, (uint32_t)k_cyc_to_us_floor64(report.cycles));
+
+    return (report.passed == report.count) ? 0 : -EIO;
+}
+
+CRC32_INDEX_DEFINE(shell_index, CRC32_INDEX_SHELL_BLOCKS);
+
+static int cmd_crc32_cache_check(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t address;
+    size_t words_len;
+    int mode;
+    uint32_t image_id = 0;
+    bool hit;
+
+    if (crc32_region_arg(sh, argv, &address, &words_len, &mode) < 0)
+    {
+        return -EINVAL;
+    }
+
+    if (argc >= 5)
+    {
+        unsigned long val;
+
+        if (crc32_num_arg(sh, argv[4], "image ID", &val) < 0)
+        {
+            return -EINVAL;
+        }
+
+        image_id = val;
+    }
+
+    uint32_t start = k_cycle_get_32();
+    struct crc_result r = crc32_words_check_cached(address, words_len, mode, image_id, &hit);
+    uint32_t cycles = k_cycle_get_32() - start;
+
+    if (r.status == CRC_INVALID)
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    if (mode == 0)
+    {
+        shell_print(sh, "0x%08X", r.crc);
+    }
+    else
+    {
+        shell_print(sh, "0x%08X 0x%08X %s",
+                    r.crc, r.crc_ref,
+                    (r.status == CRC_OK) ? "OK" : "FAIL");
+    }
+
+    shell_print(sh, "%s, %u cycles (%u us)", hit ? "cache hit" : "full pass", cycles,
+                (uint32_t)k_cyc_to_us_floor64(cycles));
+
+    return 0;
+}
+
+static int cmd_crc32_cache_list(const struct shell *sh, size_t argc, char **argv)
+{
+    struct crc32_cache_entry e;
+    int n = 0;
+
+    for (size_t i = 0; i < CRC32_CACHE_ENTRIES; i++)
+    {
+        if (crc32_cache_entry_get(i, &e) < 0)
+        {
+            continue;
+        }
+
+        shell_print(sh, "%2u: 0x%08X %u words, id 0x%08X, mode %u, crc 0x%08X",
+                    (unsigned int)i, e.address, e.words, e.image_id, e.mode, e.crc);
+        n++;
+    }
+
+    if (n == 0)
+    {
+        shell_print(sh, "Cache empty");
+    }
+
+    return 0;
+}
+
+static int cmd_crc32_cache_clear(const struct shell *sh, size_t argc, char **argv)
+{
+    crc32_cache_clear();
+    shell_print(sh, "Cache cleared");
+
+    return 0;
+}
+
+K_MUTEX_DEFINE(shell_job_lock);
+static struct crc32_job_result shell_job_results[CRC32_JOB_SHELL_RESULTS];
+static size_t shell_job_next;
+
+static void shell_job_done(const struct crc32_job_result *result, void *user_data)
+{
+    ARG_UNUSED(user_data);
+
+    k_mutex_lock(&shell_job_lock, K_FOREVER);
+    shell_job_results[shell_job_next] = *result;
+    shell_job_next = (shell_job_next + 1) % CRC32_JOB_SHELL_RESULTS;
+    k_mutex_unlock(&shell_job_lock);
+}
+
+static int cmd_crc32_job_submit(const struct shell *sh, size_t argc, char **argv)
+{
+    struct crc32_job_region regions[CRC32_JOB_REGIONS_MAX];
+    uint8_t variant = CRC32_JOB_VARIANT_WORDS;
+    size_t count = 0;
+
+    for (size_t i = 1; i < argc; i++)
+    {
+        char *end;
+
+        if (strcmp(argv[i], "-v") == 0 && (i + 1) < argc)
+        {
+            const struct crc32_variant *v = crc32_variant_find(argv[++i]);
+
+            if (v == NULL)
+            {
+                shell_print(sh, "Unknown variant: %s", argv[i]);
+                return -EINVAL;
+            }
+
+            variant = 0;
+            while (crc32_variant_get(variant) != v)
+            {
+                variant++;
+            }
+
+            continue;
+        }
+
+        if (count == ARRAY_SIZE(regions))
+        {
+            shell_print(sh, "At most %d regions", CRC32_JOB_REGIONS_MAX);
+            return -EINVAL;
+        }
+
+        regions[count].address = strtoul(argv[i], &end, 0);
+
+        if (*end != ':' || end[1] == '-' || end[1] == '\0')
+        {
+            shell_print(sh, "Invalid region %s, use <address>:<bytes>", argv[i]);
+            return -EINVAL;
+        }
+
+        regions[count].len = strtoul(end + 1, NULL, 0);
+        count++;
+    }
+
+    int id = crc32_job_submit(regions, count, variant, shell_job_done, NULL);
+
+    if (id == -EBUSY)
+    {
+        shell_print(sh, "%d jobs already in flight", CRC32_JOB_QUEUE_LEN);
+        return id;
+    }
+
+    if (id < 0)
+    {
+        shell_print(sh, "Submit failed (%d)", id);
+        return id;
+    }
+
+    shell_print(sh, "Job %d queued", id);
+
+    return 0;
+}
+
+static int cmd_crc32_job_cancel(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t id = strtoul(argv[1], NULL, 0);
+
+    if (crc32_job_cancel(id) < 0)
+    {
+        shell_print(sh, "No job %u in flight", id);
+        return -ENOENT;
+    }
+
+    shell_print(sh, "Cancel requested");
+
+    return 0;
+}
+
+static int cmd_crc32_job_results(const struct shell *sh, size_t argc, char **argv)
+{
+    static const char *const status_names[] = {
+        [CRC32_JOB_DONE] = "done",
+        [CRC32_JOB_CANCELLED] = "cancelled",
+        [CRC32_JOB_ERROR] = "error",
+    };
+
+    k_mutex_lock(&shell_job_lock, K_FOREVER);
+
+    for (size_t i = 0; i < CRC32_JOB_SHELL_RESULTS; i++)
+    {
+        const struct crc32_job_result *r =
+            &shell_job_results[(shell_job_next + i) % CRC32_JOB_SHELL_RESULTS];
+
+        if (r->id == 0)
+        {
+            continue;
+        }
+
+        /* Results can come from the other core over IPC, do not trust the status */
+        char unknown[16];
+        const char *status = NULL;
+
+        if ((unsigned int)r->status < ARRAY_SIZE(status_names))
+        {
+            status = status_names[r->status];
+        }
+
+        if (status == NULL)
+        {
+            snprintf(unknown, sizeof(unknown), "unknown(%d)", (int)r->status);
+            status = unknown;
+        }
+
+        shell_print(sh, "Job %u: %s, 0x%08X, %u bytes, service %u us, latency %u us",
+                    r->id, status, r->crc, r->bytes, r->service_us, r->latency_us);
+    }
+
+    k_mutex_unlock(&shell_job_lock);
+
+    return 0;
+}
+
+static int cmd_crc32_job_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    struct crc32_job_stats st;
+
+    crc32_job_stats_get(&st);
+
+    shell_print(sh, "submitted %u, done %u, cancelled %u, errors %u, pending %u",
+                st.submitted, st.done, st.cancelled, st.errors, st.pending);
+
+    if (st.done > 0)
+    {
+        /* Bytes per microsecond equals MB/s */
+        shell_print(sh, "latency avg %u us, max %u us, throughput %u MB/s",
+                    (uint32_t)(st.latency_us / st.done), st.latency_max_us,
+                    (uint32_t)(st.bytes / MAX(st.service_us, 1u)));
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "-r") == 0)
+    {
+        crc32_job_stats_reset();
+    }
+
+    return 0;
+}
+
+static int cmd_crc32_index_build(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t address;
+    size_t words_len;
+    size_t block_words = CRC32_INDEX_BLOCK_WORDS_DEFAULT;
+
+    if (crc32_region_arg(sh, argv, &address, &words_len, NULL) < 0)
+    {
+        return -EINVAL;
+    }
+
+    if (argc >= 4)
+    {
+        unsigned long val;
+
+        if (crc32_num_arg(sh, argv[3], "block size", &val) < 0)
+        {
+            return -EINVAL;
+        }
+
+        block_words = val;
+    }
+
+    uint32_t start = k_cycle_get_32();
+
+    if (crc32_index_build(&shell_index, address, words_len, block_words) < 0)
+    {
+        shell_print(sh, "Invalid parameters (at most %d blocks)", CRC32_INDEX_SHELL_BLOCKS);
+        return -EINVAL;
+    }
+
+    uint32_t cycles = k_cycle_get_32() - start;
+
+    shell_print(sh, "0x%08X, %u blocks, %u cycles (%u us)",
+                shell_index.crc, (unsigned int)shell_index.blocks, cycles,
+                (uint32_t)k_cyc_to_us_floor64(cycles));
+
+    return 0;
+}
+
+static int cmd_crc32_index_dirty(const struct shell *sh, size_t argc, char **argv)
+{
+    size_t offset = strtoul(argv[1], NULL, 0);
+    size_t len    = strtoul(argv[2], NULL, 0);
+
+    if (crc32_index_mark_dirty(&shell_index, offset, len) < 0)
+    {
+        shell_print(sh, "Range outside the indexed region");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+static int cmd_crc32_index_check(const struct shell *sh, size_t argc, char **argv)
+{
+    int mode;
+    size_t samples = 0;
+
+    if (strcmp(argv[1], "0") == 0)
+    {
+        mode = 0;
+    }
+    else if (strcmp(argv[1], "1") == 0)
+    {
+        mode = 1;
+    }
+    else
+    {
+        shell_print(sh, "Invalid mode, use 0 or 1");
+        return -EINVAL;
+    }
+
+    if (argc >= 4 && strcmp(argv[2], "-s") == 0)
+    {
+        samples = strtoul(argv[3], NULL, 0);
+    }
+
+    uint32_t start = k_cycle_get_32();
+    size_t changed = crc32_index_sample(&shell_index, samples);
+    size_t hashed = crc32_index_refresh(&shell_index);
+    struct crc_result r = crc32_index_check(&shell_index, mode);
+    uint32_t cycles = k_cycle_get_32() - start;
+
+    if (r.status == CRC_INVALID)
+    {
+        shell_print(sh, "No region indexed");
+        return -EINVAL;
+    }
+
+    if (mode == 0)
+    {
+        shell_print(sh, "0x%08X", r.crc);
+    }
+    else
+    {
+        shell_print(sh, "0x%08X 0x%08X %s",
+                    r.crc, r.crc_ref,
+                    (r.status == CRC_OK) ? "OK" : "FAIL");
+    }
+
+    shell_print(sh, "%u dirty, %u sampled (%u changed), %u cycles (%u us)",
+                (unsigned int)hashed, (unsigned int)MIN(samples, shell_index.blocks),
+                (unsigned int)changed, cycles, (uint32_t)k_cyc_to_us_floor64(cycles));
+
+    return 0;
+}
+
+static int cmd_crc32_scrub_add(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t address;
+    size_t words_len;
+    uint32_t golden;
+
+    if (crc32_region_arg(sh, argv, &address, &words_len, NULL) < 0)
+    {
+        return -EINVAL;
+    }
+
+    if (!crc32_words_valid(address, words_len))
+    {
+        shell_print(sh, "Invalid parameters");
+        return -EINVAL;
+    }
+
+    /* Without a golden CRC the current contents are taken as golden */
+    if (argc >= 4)
+    {
+        unsigned long val;
+
+        if (crc32_num_arg(sh, argv[3], "golden CRC", &val) < 0)
+        {
+            return -EINVAL;
+        }
+
+        golden = val;
+    }
+    else
+    {
+        golden = crc32_bzip2_words((const uint32_t *)address, words_len);
+    }
+
+    int index = crc32_scrub_add(address, words_len, golden);
+
+    if (index == -EINVAL)
+    {
+        shell_print(sh, "Invalid parameters");
+        return index;
+    }
+
+    if (index < 0)
+    {
+        shell_print(sh, "At most %d regions", CRC32_SCRUB_REGIONS_MAX);
+        return index;
+    }
+
+    shell_print(sh, "region %d: 0x%08X %u words, golden 0x%08X",
+                index, address, (unsigned int)words_len, golden);
+
+    return 0;
+}
+
+static int cmd_crc32_scrub_budget(const struct shell *sh, size_t argc, char **argv)
+{
+    struct crc32_scrub_status st;
+    uint32_t period_ms;
+
+    crc32_scrub_status_get(&st);
+    period_ms = (argc >= 3) ? strtoul(argv[2], NULL, 0) : st.period_ms;
+
+    if (crc32_scrub_set_budget(strtoul(argv[1], NULL, 0), period_ms) < 0)
+    {
+        shell_print(sh, "Duty must be 1-100 %%");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+static int cmd_crc32_scrub_start(const struct shell *sh, size_t argc, char **argv)
+{
+    crc32_scrub_start();
+    return 0;
+}
+
+static int cmd_crc32_scrub_stop(const struct shell *sh, size_t argc, char **argv)
+{
+    crc32_scrub_stop();
+    return 0;
+}
+
+static int cmd_crc32_scrub_clear(const struct shell *sh, size_t argc, char **argv)
+{
+    crc32_scrub_clear();
+    return 0;
+}
+
+static int cmd_crc32_scrub_status(const struct shell *sh, size_t argc, char **argv)
+{
+    struct crc32_scrub_status st;
+    struct crc32_scrub_region r;
+
+    crc32_scrub_status_get(&st);
+
+    shell_print(sh, "%s, %u%% duty (%u.%u%% used), period %u ms",
+                st.running ? "running" : "stopped", st.duty_percent,
+                st.busy_permille / 10, st.busy_permille % 10, st.period_ms);
+    shell_print(sh, "%u passes, %u mismatches", st.passes, st.mismatches);
+
+    for (size_t i = 0; crc32_scrub_region_get(i, &r) == 0; i++)
+    {
+        shell_print(sh, "%u 0x%08X %8u golden 0x%08X last 0x%08X %u/%u %s",
+                    (unsigned int)i, r.address, (unsigned int)r.words, r.golden,
+                    r.last_crc, r.failures, r.checks,
+                    (r.checks == 0) ? "-" : (r.last_crc == r.golden) ? "OK" : "FAIL");
+    }
+
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_crc32_scrub,
+    SHELL_CMD_ARG(add, NULL,
+                  "Add a region: add <address> <words> [<golden crc>]",
+                  cmd_crc32_scrub_add, 3, 1),
+    SHELL_CMD_ARG(budget, NULL,
+                  "CPU budget: budget <duty %> [<period ms>]",
+                  cmd_crc32_scrub_budget, 2, 1),
+    SHELL_CMD(start, NULL, "Start scrubbing", cmd_crc32_scrub_start),
+    SHELL_CMD(stop, NULL, "Stop scrubbing", cmd_crc32_scrub_stop),
+    SHELL_CMD(clear, NULL, "Remove all regions", cmd_crc32_scrub_clear),
+    SHELL_CMD(status, NULL, "Show scrubber state and regions", cmd_crc32_scrub_status),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_crc32_index,
+    SHELL_CMD_ARG(build, NULL,
+                  "Hash a region per block: build <address> <words> [<block words>]",
+                  cmd_crc32_index_build, 3, 1),
+    SHELL_CMD_ARG(dirty, NULL,
+                  "Mark changed bytes: dirty <offset> <bytes>",
+                  cmd_crc32_index_dirty, 3, 0),
+    SHELL_CMD_ARG(check, NULL,
+                  "Re-hash dirty blocks and verify: check <mode> [-s <blocks>]",
+                  cmd_crc32_index_check, 2, 2),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_crc32_cache,
+    SHELL_CMD_ARG(check, NULL,
+                  "Check through the golden-CRC cache: check <address> <words> <mode> [<image id>]",
+                  cmd_crc32_cache_check, 4, 1),
+    SHELL_CMD_ARG(list, NULL, "Show cached regions", cmd_crc32_cache_list, 1, 0),
+    SHELL_CMD_ARG(clear, NULL, "Forget all cached regions", cmd_crc32_cache_clear, 1, 0),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_crc32_job,
+    SHELL_CMD_ARG(submit, NULL,
+                  "Queue a CRC job: submit [-v <variant>] <address>:<bytes> ... "
+                  "(bzip2 word order without -v)",
+                  cmd_crc32_job_submit, 2, CRC32_JOB_REGIONS_MAX + 2),
+    SHELL_CMD_ARG(cancel, NULL, "Cancel a job: cancel <id>", cmd_crc32_job_cancel, 2, 0),
+    SHELL_CMD_ARG(results, NULL, "Show the last job results", cmd_crc32_job_results, 1, 0),
+    SHELL_CMD_ARG(stats, NULL, "Latency and throughput, -r resets: stats [-r]",
+                  cmd_crc32_job_stats, 1, 1),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_crc32,
+    SHELL_CMD_ARG(bench, NULL,
+                  "Compare CRC kernels: bench <address> <words> [iterations]",
+                  cmd_crc32_bench, 3, 1),
+    SHELL_CMD_ARG(variant, NULL,
+                  "CRC with a named variant: variant <name> <address> <bytes>",
+                  cmd_crc32_variant, 1, 3),
+    SHELL_COND_CMD_ARG(CONFIG_CRC32_FUSED, digest, NULL,
+                       "Several digests in one pass: digest <address> <words> "
+                       "[bzip2] [crc32c] [sha256] [-t]",
+                       cmd_crc32_digest, 3, 4),
+    SHELL_CMD_ARG(locate, NULL,
+                  "Locate flipped bits from the CRC syndrome, -r repairs them (RAM only): "
+                  "locate <address> <words> [-r]",
+                  cmd_crc32_locate, 3, 1),
+    SHELL_CMD_ARG(segments, NULL,
+                  "CRC over concatenated regions, -r for bzip2 word order: "
+                  "segments [-r] <address>:<bytes> ...",
+                  cmd_crc32_segments, 2, CRC32_SEGMENTS_SHELL_MAX),
+    SHELL_CMD_ARG(pipeline, NULL,
+                  "CRC through RAM bounce buffers: pipeline <address> <words> <mode> "
+                  "[<chunk words> [<buffers>]]",
+                  cmd_crc32_pipeline, 4, 2),
+    SHELL_CMD_ARG(manifest, NULL,
+                  "Verify all manifest regions: manifest [<blob address>] [-v]",
+                  cmd_crc32_manifest, 1, 2),
+    SHELL_CMD(index, &sub_crc32_index,
+              "Block CRC index for incremental re-verification", NULL),
+    SHELL_CMD(scrub, &sub_crc32_scrub,
+              "Background memory scrubber", NULL),
+    SHELL_CMD(cache, &sub_crc32_cache,
+              "Golden-CRC cache across resets", NULL),
+    SHELL_CMD(job, &sub_crc32_job,
+              "CRC jobs on a local or remote executor", NULL),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(crc32, &sub_crc32,
+                   "crc32 test command",
+                   cmd_crc32);
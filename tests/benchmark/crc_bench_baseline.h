@@ -0,0 +1,63 @@
+#ifndef CRC_BENCH_BASELINE_H
+#define CRC_BENCH_BASELINE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Cycles per byte of every implementation over the largest region,
+ * relative to Zephyr's crc32_ieee() in the same run, x1000. Ratios keep the
+ * gate independent of the host or emulator speed, but not of the compiler
+ * and ISA, so every board with the gate on has its own column; refresh it
+ * from the "Regression gate" output after an intended change. 0 or a
+ * missing name disables the check.
+ */
+struct crc_bench_baseline
+{
+    const char *name;
+    uint32_t ratio_x1000;
+};
+
+#if defined(CONFIG_BOARD_QEMU_X86)
+/*
+ * qemu_x86 with icount, slicing tier, -Os. icount charges a fixed virtual
+ * time per instruction, so these are instruction count ratios over
+ * 64 KiB. There is no PCLMULQDQ in the emulated CPU; clmul is gated as
+ * slice8.
+ */
+static const struct crc_bench_baseline crc_bench_baselines[] = {
+    { "byte",     1516 },
+    { "slice8",    234 },
+    { "forward",   225 },
+    { "stream",    258 },
+    { "engine_c",  227 },
+    { "iso_hdlc",  227 },
+};
+#else
+/* native_sim on an x86-64 host, slicing tier, TSC cycles over 4 MiB */
+static const struct crc_bench_baseline crc_bench_baselines[] = {
+    { "byte",     600 },
+    { "slice8",   105 },
+    { "forward",  100 },
+    { "clmul",     12 },
+    { "stream",   190 },
+    { "engine_c", 110 },
+    { "iso_hdlc", 100 },
+};
+#endif
+
+static inline uint32_t crc_bench_baseline_ratio(const char *name)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(crc_bench_baselines); i++)
+    {
+        if (strcmp(crc_bench_baselines[i].name, name) == 0)
+        {
+            return crc_bench_baselines[i].ratio_x1000;
+        }
+    }
+
+    return 0;
+}
+
+#endif // CRC_BENCH_BASELINE_H
@@ -0,0 +1,338 @@
+#include <zephyr/ztest.h>
+#include <zephyr/cache.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/crc.h>
+
+#include "crc32.h"
+#include "crc32_test.h"
+#include "crc32_stream.h"
+#include "crc32_engine.h"
+#include "crc32_clmul.h"
+#include "crc_bench_baseline.h"
+
+#if defined(CONFIG_ARCH_POSIX) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define BENCH_CLOCK_TSC 1
+#endif
+
+/* Warm runs repeat a region until at least this many bytes were hashed */
+#define BENCH_MIN_BYTES (256 * 1024)
+/* Best of this many rounds is reported */
+#define BENCH_ROUNDS    3
+#define BENCH_MIN_SIZE  16
+
+struct bench_impl
+{
+    const char *name;
+    /* Word kernels need 4-byte alignment and a multiple of 4 bytes */
+    bool words;
+    enum crc_kernel kernel;
+    uint32_t (*fn)(const uint8_t *data, size_t len);
+};
+
+struct bench_sample
+{
+    uint64_t cycles;
+    uint64_t bytes;
+};
+
+static uint8_t bench_buf[CONFIG_CRC_BENCH_MAX_SIZE + 64] __aligned(64);
+
+#if CONFIG_CRC_BENCH_EVICT_SIZE > 0
+static uint8_t evict_buf[CONFIG_CRC_BENCH_EVICT_SIZE] __aligned(64);
+#endif
+
+static volatile uint32_t bench_sink;
+
+static uint32_t bench_stream(const uint8_t *data, size_t len)
+{
+    struct crc32_ctx ctx;
+
+    crc32_ctx_init(&ctx, CRC32_ORDER_FORWARD);
+    crc32_ctx_update(&ctx, data, len);
+    return crc32_ctx_final(&ctx);
+}
+
+static uint32_t bench_engine_c(const uint8_t *data, size_t len)
+{
+    return crc32_engine_compute(&crc32_variant_c, data, len);
+}
+
+static uint32_t bench_engine_iso_hdlc(const uint8_t *data, size_t len)
+{
+    return crc32_engine_compute(&crc32_variant_iso_hdlc, data, len);
+}
+
+static uint32_t bench_zephyr_ieee(const uint8_t *data, size_t len)
+{
+    return crc32_ieee(data, len);
+}
+
+static const struct bench_impl bench_impls[] = {
+    { "byte",       true,  CRC_KERNEL_BYTE,    NULL },
+    { "slice8",     true,  CRC_KERNEL_SLICE8,  NULL },
+    { "forward",    true,  CRC_KERNEL_FORWARD, NULL },
+    { "clmul",      true,  CRC_KERNEL_CLMUL,   NULL },
+    { "stream",     false, 0, bench_stream },
+    { "engine_c",   false, 0, bench_engine_c },
+    { "iso_hdlc",   false, 0, bench_engine_iso_hdlc },
+    { "crc32_ieee", false, 0, bench_zephyr_ieee },
+};
+
+#define BENCH_IMPL_IEEE (ARRAY_SIZE(bench_impls) - 1)
+
+/*
+ * native_sim does not advance simulated time while the CPU is busy, so
+ * k_cycle_get_32() would read 0 there; use the host TSC instead.
+ */
+static inline uint64_t bench_now(void)
+{
+#if defined(BENCH_CLOCK_TSC)
+    return __rdtsc();
+#elif defined(CONFIG_TIMING_FUNCTIONS)
+    return timing_counter_get();
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+static inline uint64_t bench_elapsed(uint64_t start, uint64_t end)
+{
+#if defined(BENCH_CLOCK_TSC)
+    return end - start;
+#elif defined(CONFIG_TIMING_FUNCTIONS)
+    timing_t s = start;
+    timing_t e = end;
+
+    return timing_cycles_get(&s, &e);
+#else
+    return (uint32_t)((uint32_t)end - (uint32_t)start);
+#endif
+}
+
+static uint32_t bench_clock_mhz(void)
+{
+#if defined(BENCH_CLOCK_TSC)
+    return CONFIG_CRC_BENCH_TSC_MHZ;
+#elif defined(CONFIG_TIMING_FUNCTIONS)
+    return MAX(timing_freq_get_mhz(), 1u);
+#else
+    return MAX(sys_clock_hw_cycles_per_sec() / 1000000u, 1u);
+#endif
+}
+
+static void bench_evict(void)
+{
+#if CONFIG_CRC_BENCH_EVICT_SIZE > 0
+    volatile uint8_t *p = evict_buf;
+
+    for (size_t i = 0; i < sizeof(evict_buf); i += 32)
+    {
+        p[i]++;
+    }
+#elif defined(CONFIG_DCACHE)
+    sys_cache_data_flush_and_invd_all();
+#endif
+}
+
+static uint32_t bench_run(const struct bench_impl *impl, const uint8_t *data, size_t len)
+{
+    if (impl->words)
+    {
+        return crc32_bzip2_words_kernel((const uint32_t *)data, len / sizeof(uint32_t),
+                                        impl->kernel);
+    }
+
+    return impl->fn(data, len);
+}
+
+static struct bench_sample bench_measure(const struct bench_impl *impl, const uint8_t *data,
+                                         size_t len, bool cold)
+{
+    struct bench_sample best = { .cycles = UINT64_MAX };
+    size_t reps = cold ? 1 : MAX(BENCH_MIN_BYTES / len, 1u);
+
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        if (cold)
+        {
+            bench_evict();
+        }
+
+        uint64_t start = bench_now();
+
+        for (size_t r = 0; r < reps; r++)
+        {
+            bench_sink = bench_run(impl, data, len);
+        }
+
+        uint64_t cycles = bench_elapsed(start, bench_now());
+
+        if (cycles < best.cycles)
+        {
+            best.cycles = cycles;
+        }
+    }
+
+    best.cycles = MAX(best.cycles, 1u);
+    best.bytes = (uint64_t)len * reps;
+
+    return best;
+}
+
+static uint32_t bench_cpb_x100(struct bench_sample s)
+{
+    return (uint32_t)((s.cycles * 100) / s.bytes);
+}
+
+static uint32_t bench_mbps(struct bench_sample s)
+{
+    /* bytes per microsecond equals MB/s */
+    return (uint32_t)((s.bytes * bench_clock_mhz()) / s.cycles);
+}
+
+static void bench_table(const char *title, bool misaligned, bool cold)
+{
+    TC_PRINT("%s (clock %u MHz)\n", title, bench_clock_mhz());
+    TC_PRINT("impl         size       cyc/B     MB/s\n");
+
+    for (size_t i = 0; i < ARRAY_SIZE(bench_impls); i++)
+    {
+        const struct bench_impl *impl = &bench_impls[i];
+
+        if (impl->words && !crc32_kernel_built(impl->kernel))
+        {
+            continue;
+        }
+
+        /*
+        * Word kernels only accept word aligned regions, so their
+        * misaligned run starts 4 bytes into a cache line; the byte
+        * oriented implementations start on an odd address.
+        */
+        size_t offset = misaligned ? (impl->words ? 4 : 1) : 0;
+
+        for (size_t len = BENCH_MIN_SIZE; len <= CONFIG_CRC_BENCH_MAX_SIZE; len *= 4)
+        {
+            struct bench_sample s = bench_measure(impl, &bench_buf[offset], len, cold);
+            uint32_t cpb = bench_cpb_x100(s);
+
+            TC_PRINT("%-10s %8u  %6u.%02u  %7u\n", impl->name, (unsigned int)len,
+                     cpb / 100, cpb % 100, bench_mbps(s));
+        }
+    }
+}
+
+static void *bench_setup(void)
+{
+    uint32_t seed = 0x2545F491;
+
+    for (size_t i = 0; i < sizeof(bench_buf); i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        bench_buf[i] = (uint8_t)(seed >> 24);
+    }
+
+#if defined(CONFIG_TIMING_FUNCTIONS) && !defined(BENCH_CLOCK_TSC)
+    timing_init();
+    timing_start();
+#endif
+
+    return NULL;
+}
+
+ZTEST(crc_bench, test_results_match)
+{
+    for (size_t len = BENCH_MIN_SIZE; len <= CONFIG_CRC_BENCH_MAX_SIZE; len *= 4)
+    {
+        uint32_t ref = bench_run(&bench_impls[0], bench_buf, len);
+
+        for (size_t i = 1; i < ARRAY_SIZE(bench_impls); i++)
+        {
+            if (!bench_impls[i].words)
+            {
+                continue;
+            }
+
+            uint32_t crc = bench_run(&bench_impls[i], bench_buf, len);
+
+            zassert_equal(crc, ref, "%s len %u: got 0x%08X expected 0x%08X",
+                          bench_impls[i].name, (unsigned int)len, crc, ref);
+        }
+
+        /* The engine's reflected variant must agree with Zephyr's CRC-32 */
+        zassert_equal(bench_engine_iso_hdlc(bench_buf, len), crc32_ieee(bench_buf, len),
+                      "iso_hdlc differs from crc32_ieee at len %u", (unsigned int)len);
+        zassert_equal(bench_stream(bench_buf, len),
+                      crc32_engine_compute(&crc32_variant_bzip2, bench_buf, len),
+                      "stream differs from the bzip2 engine at len %u", (unsigned int)len);
+    }
+}
+
+ZTEST(crc_bench, test_aligned)
+{
+    bench_table("Aligned, warm cache", false, false);
+}
+
+ZTEST(crc_bench, test_misaligned)
+{
+    bench_table("Misaligned, warm cache", true, false);
+}
+
+ZTEST(crc_bench, test_cache_cold)
+{
+    bench_table("Aligned, cache cold", false, true);
+}
+
+ZTEST(crc_bench, test_regression_gate)
+{
+    if (!IS_ENABLED(CONFIG_CRC_BENCH_GATE))
+    {
+        ztest_test_skip();
+    }
+
+    size_t len = CONFIG_CRC_BENCH_MAX_SIZE;
+    struct bench_sample ieee = bench_measure(&bench_impls[BENCH_IMPL_IEEE], bench_buf,
+                                             len, false);
+    int failed = 0;
+
+    TC_PRINT("Regression gate, %u bytes, ratio to crc32_ieee x1000\n", (unsigned int)len);
+
+    for (size_t i = 0; i < ARRAY_SIZE(bench_impls); i++)
+    {
+        const struct bench_impl *impl = &bench_impls[i];
+        const char *name = impl->name;
+
+        /* Without PCLMULQDQ the clmul kernel runs slice8 */
+        if (impl->words && impl->kernel == CRC_KERNEL_CLMUL && !crc32_clmul_available())
+        {
+            name = "slice8";
+        }
+
+        uint32_t limit = crc_bench_baseline_ratio(name);
+
+        if (i == BENCH_IMPL_IEEE || limit == 0 ||
+            (impl->words && !crc32_kernel_built(impl->kernel)))
+        {
+            continue;
+        }
+
+        struct bench_sample s = bench_measure(impl, bench_buf, len, false);
+
+        /* Both samples hash the same byte count */
+        uint32_t ratio = (uint32_t)((s.cycles * 1000) / ieee.cycles);
+        uint32_t allowed = limit * (100 + CONFIG_CRC_BENCH_GATE_TOLERANCE) / 100;
+
+        TC_PRINT("%-10s %5u  baseline %5u  limit %5u  %s\n", impl->name, ratio, limit,
+                 allowed, ratio <= allowed ? "ok" : "REGRESSION");
+
+        if (ratio > allowed)
+        {
+            failed++;
+        }
+    }
+
+    zassert_equal(failed, 0, "%d implementation(s) slower than the baseline", failed);
+}
+
+ZTEST_SUITE(crc_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -1,236 +1,933 @@
-#include <zephyr/ztest.h>
-
-#include "crc32.h"
-
-static const uint32_t crc_checksum = 0x840DD644;
-
-static const uint32_t test_data[] = {
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0x00000000, 0x00000010, 0x00000075, 0x00000010,
-    0x00000000, 0x00000000, 0x0000000A, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000003, 0x00000001, 0x00000000, 0x00000000,
-    0x00000020, 0x0000001C, 0x00000000, 0x00000000,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0x0000000D, 0x00000000, 0xFFFFFFFF,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000013, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000010, 0x00000008,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000013,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0x00000008, 0x00000000,
-    0x00000008, 0x00000008, 0x00000008, 0x00000000,
-    0x00000008, 0x00000008, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0x00000008, 0x00000008,
-    0x00000019, 0x00000000, 0x00000000, 0xFFFFFFFF,
-    0xFFFFFFFF, 0x00000000, 0x00000000, 0x0000000F,
-    0x00000008, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0x00000005, 0x0000006E, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000050,
-    0x00000002, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x000000BE, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x0000000F,
-    0x00000008, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0x00000007, 0x00000005, 0x0000006E, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0x00000030, 0x00000050,
-    0x00000002, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000001,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x0000000F,
-    0x00000008, 0x0000006E, 0x00000002, 0x00000013,
-    0x00000100, 0xFFFFFFFF, 0x00000000, 0x00000001,
-    0x0000000F, 0x00000008, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0x00000007, 0x00000005, 0x0000006E,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000030,
-    0x00000050, 0x0000000F, 0x0000000B, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0x0000006C, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000002,
-    0x00000002, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0x0000000F, 0x00000008, 0x0000006E, 0x00000002,
-    0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0x00000000, 0x0000000F, 0x0000000B, 0x00000008,
-    0x00000006, 0x00000003, 0xFFFFFFFF, 0x0000006C,
-    0x0000006E, 0x00000042, 0x00000074, 0xFFFFFFFF,
-    0x00000002, 0x00000000, 0x00000000, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0x0000000F, 0x00000006,
-    0x00000042, 0x00000002, 0x00000000, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00002000, 0x00000004, 0x00000000, 0x00000004,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00131613, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0x00000000, 0x0E01F030, 0x2E03F0F0,
-    0x00000000, 0x00000000, 0x542221C8, 0x0B0003D9,
-    0x0B008204, 0x0F000000, 0x0F002430, 0x0F004D6A,
-    0x0F00620C, 0x00000007, 0x0F006000, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,
-    0x00000000, 0x00000000, 0x00000000, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0x0000004F, 0xFDE55120, 0xFFE5B520, 0x21E5B510,
-    0x22E5B511, 0x20E5B504, 0xFEE5B520, 0x00E55105,
-    0x01E55110, 0x02E55111, 0xFFE59120, 0x32E59110,
-    0x33E59111, 0x34E59112, 0x35E59113, 0x36E59114,
-    0xFEE59120, 0x03E55113, 0xFFE5C120, 0x65E5C110,
-    0x66E5C111, 0xFEE5C120, 0x04E55114, 0xFFE5C520,
-    0x62E5C510, 0x63E5C511, 0x64E5C506, 0xFEE5C520,
-    0x05E55112, 0xFFE5A520, 0x52E5A510, 0x53E5A511,
-    0x54E5A512, 0x55E5A513, 0xFEE5A520, 0xFEE55120,
-    0xFFE5A920, 0x56E5A910, 0x57E5A911, 0x58E5A912,
-    0x59E5A913, 0xFEE5A920, 0xFFE55003, 0x25E5F202,
-    0x26E5F203, 0x27E5F204, 0x28E5F206, 0x29E5F207,
-    0x2AE5F208, 0x2BE5F20A, 0x2CE5F20B, 0x2DE5F20E,
-    0x2EE5F20F, 0x2FE5F20C, 0x30E5F20D, 0x31E5F205,
-    0xFEE5F120, 0x37E5EE02, 0x38E5EE03, 0x39E5EE04,
-    0x3AE5EE06, 0x3BE5EE07, 0x3CE5EE08, 0x3DE5EE0A,
-    0x3EE5EE0B, 0x3FE5EE0E, 0x40E5EE0F, 0x41E5EE0C,
-    0x42E5EE0D, 0x43E5EE05, 0xFEE5ED20, 0x6AE5D910,
-    0xFEE5D920, 0x69E5D510, 0xFEE5D520, 0x23E5AD10,
-    0x24E5AD11, 0xFEE5AD20, 0x13E5E510, 0xFEE5E520,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0x00000000, 0x00000003, 0x00000008,
-    0x00000008, 0x00000014, 0x0000000A, 0x00000001,
-    0x00000000, 0x00000000, 0x00000000, 0x0000001B,
-    0x0000001B, 0x0000000A, 0x00000001, 0x00000000,
-    0x00000000, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF,
-    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF
-};
-
-ZTEST(crc_suite, crc32)
-{
-    uint32_t crc;
-    BZ2_initialise_crc(&crc);
-
-    const uint32_t *data = test_data;
-    size_t words_len = sizeof(test_data) / sizeof(test_data[0]);
-
-    /*
-     * Input order matches bzip2 CRC32 implementation:
-     * words are processed in reverse order and bytes MSB-first.
-     */
-    for (size_t w = words_len; w > 0; w--) 
-    {
-        uint32_t v = data[w - 1];
-
-        uint8_t b0 = (v >> 24) & 0xFF;
-        uint8_t b1 = (v >> 16) & 0xFF;
-        uint8_t b2 = (v >> 8)  & 0xFF;
-        uint8_t b3 =  v        & 0xFF;
-
-        BZ2_update_crc(&crc, b0);
-        BZ2_update_crc(&crc, b1);
-        BZ2_update_crc(&crc, b2);
-        BZ2_update_crc(&crc, b3);
-    }
-
-    BZ2_finalise_crc(&crc);
-
-    zassert_equal(crc, crc_checksum,
-                  "CRC mismatch: got 0x%08X expected 0x%08X",
-                  crc, crc_checksum);
-}
-
-ZTEST_SUITE(crc_suite, NULL, NULL, NULL, NULL, NULL);
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+#include "crc32.h"
+#include "crc32_test.h"
+#include "crc32_stream.h"
+#include "crc32_parallel.h"
+#include "crc32_engine.h"
+#include "crc32_manifest.h"
+#include "crc32_index.h"
+#include "crc32_scrub.h"
+#include "crc32_fused.h"
+#include "crc32_pipeline.h"
+#include "crc32_syndrome.h"
+#include "crc32_cache.h"
+#include "crc32_job.h"
+
+static const uint32_t crc_checksum = 0x840DD644;
+
+static const uint32_t test_data[] = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0x00000000, 0x00000010, 0x00000075, 0x00000010,
+    0x00000000, 0x00000000, 0x0000000A, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000003, 0x00000001, 0x00000000, 0x00000000,
+    0x00000020, 0x0000001C, 0x00000000, 0x00000000,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0x0000000D, 0x00000000, 0xFFFFFFFF,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000013, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000010, 0x00000008,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000013,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0x00000008, 0x00000000,
+    0x00000008, 0x00000008, 0x00000008, 0x00000000,
+    0x00000008, 0x00000008, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0x00000008, 0x00000008,
+    0x00000019, 0x00000000, 0x00000000, 0xFFFFFFFF,
+    0xFFFFFFFF, 0x00000000, 0x00000000, 0x0000000F,
+    0x00000008, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0x00000005, 0x0000006E, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000050,
+    0x00000002, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x000000BE, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x0000000F,
+    0x00000008, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0x00000007, 0x00000005, 0x0000006E, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0x00000030, 0x00000050,
+    0x00000002, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000001,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x0000000F,
+    0x00000008, 0x0000006E, 0x00000002, 0x00000013,
+    0x00000100, 0xFFFFFFFF, 0x00000000, 0x00000001,
+    0x0000000F, 0x00000008, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0x00000007, 0x00000005, 0x0000006E,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000030,
+    0x00000050, 0x0000000F, 0x0000000B, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0x0000006C, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000002,
+    0x00000002, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0x0000000F, 0x00000008, 0x0000006E, 0x00000002,
+    0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0x00000000, 0x0000000F, 0x0000000B, 0x00000008,
+    0x00000006, 0x00000003, 0xFFFFFFFF, 0x0000006C,
+    0x0000006E, 0x00000042, 0x00000074, 0xFFFFFFFF,
+    0x00000002, 0x00000000, 0x00000000, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0x0000000F, 0x00000006,
+    0x00000042, 0x00000002, 0x00000000, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00002000, 0x00000004, 0x00000000, 0x00000004,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00131613, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0x00000000, 0x0E01F030, 0x2E03F0F0,
+    0x00000000, 0x00000000, 0x542221C8, 0x0B0003D9,
+    0x0B008204, 0x0F000000, 0x0F002430, 0x0F004D6A,
+    0x0F00620C, 0x00000007, 0x0F006000, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0x0000004F, 0xFDE55120, 0xFFE5B520, 0x21E5B510,
+    0x22E5B511, 0x20E5B504, 0xFEE5B520, 0x00E55105,
+    0x01E55110, 0x02E55111, 0xFFE59120, 0x32E59110,
+    0x33E59111, 0x34E59112, 0x35E59113, 0x36E59114,
+    0xFEE59120, 0x03E55113, 0xFFE5C120, 0x65E5C110,
+    0x66E5C111, 0xFEE5C120, 0x04E55114, 0xFFE5C520,
+    0x62E5C510, 0x63E5C511, 0x64E5C506, 0xFEE5C520,
+    0x05E55112, 0xFFE5A520, 0x52E5A510, 0x53E5A511,
+    0x54E5A512, 0x55E5A513, 0xFEE5A520, 0xFEE55120,
+    0xFFE5A920, 0x56E5A910, 0x57E5A911, 0x58E5A912,
+    0x59E5A913, 0xFEE5A920, 0xFFE55003, 0x25E5F202,
+    0x26E5F203, 0x27E5F204, 0x28E5F206, 0x29E5F207,
+    0x2AE5F208, 0x2BE5F20A, 0x2CE5F20B, 0x2DE5F20E,
+    0x2EE5F20F, 0x2FE5F20C, 0x30E5F20D, 0x31E5F205,
+    0xFEE5F120, 0x37E5EE02, 0x38E5EE03, 0x39E5EE04,
+    0x3AE5EE06, 0x3BE5EE07, 0x3CE5EE08, 0x3DE5EE0A,
+    0x3EE5EE0B, 0x3FE5EE0E, 0x40E5EE0F, 0x41E5EE0C,
+    0x42E5EE0D, 0x43E5EE05, 0xFEE5ED20, 0x6AE5D910,
+    0xFEE5D920, 0x69E5D510, 0xFEE5D520, 0x23E5AD10,
+    0x24E5AD11, 0xFEE5AD20, 0x13E5E510, 0xFEE5E520,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0x00000000, 0x00000003, 0x00000008,
+    0x00000008, 0x00000014, 0x0000000A, 0x00000001,
+    0x00000000, 0x00000000, 0x00000000, 0x0000001B,
+    0x0000001B, 0x0000000A, 0x00000001, 0x00000000,
+    0x00000000, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF
+};
+
+ZTEST(crc_suite, crc32)
+{
+    uint32_t crc;
+    BZ2_initialise_crc(&crc);
+
+    const uint32_t *data = test_data;
+    size_t words_len = sizeof(test_data) / sizeof(test_data[0]);
+
+    /*
+     * Input order matches bzip2 CRC32 implementation:
+     * words are processed in reverse order and bytes MSB-first.
+     */
+    for (size_t w = words_len; w > 0; w--) 
+    {
+        uint32_t v = data[w - 1];
+
+        uint8_t b0 = (v >> 24) & 0xFF;
+        uint8_t b1 = (v >> 16) & 0xFF;
+        uint8_t b2 = (v >> 8)  & 0xFF;
+        uint8_t b3 =  v        & 0xFF;
+
+        BZ2_update_crc(&crc, b0);
+        BZ2_update_crc(&crc, b1);
+        BZ2_update_crc(&crc, b2);
+        BZ2_update_crc(&crc, b3);
+    }
+
+    BZ2_finalise_crc(&crc);
+
+    zassert_equal(crc, crc_checksum,
+                  "CRC mismatch: got 0x%08X expected 0x%08X",
+                  crc, crc_checksum);
+}
+
+ZTEST(crc_suite, crc32_slice8)
+{
+    uint32_t crc;
+    BZ2_initialise_crc(&crc);
+
+    size_t words_len = sizeof(test_data) / sizeof(test_data[0]);
+
+    /* Same reverse word order as above, two words per table step */
+    BZ2_update_crc_words_rev(&crc, test_data, words_len);
+
+    BZ2_finalise_crc(&crc);
+
+    zassert_equal(crc, crc_checksum,
+                  "CRC mismatch: got 0x%08X expected 0x%08X",
+                  crc, crc_checksum);
+}
+
+ZTEST(crc_suite, crc32_forward)
+{
+    uint32_t crc;
+    uint32_t acc = 0;
+    BZ2_initialise_crc(&crc);
+
+    size_t words_len = sizeof(test_data) / sizeof(test_data[0]);
+    size_t split = 77;
+
+    /* Front-to-back in two pieces, then shift into the reverse-order CRC */
+    BZ2_update_crc_words_fwd(&acc, test_data, split);
+    BZ2_update_crc_words_fwd(&acc, &test_data[split], words_len - split);
+    BZ2_update_crc_fwd_finish(&crc, acc, words_len);
+
+    BZ2_finalise_crc(&crc);
+
+    zassert_equal(crc, crc_checksum,
+                  "CRC mismatch: got 0x%08X expected 0x%08X",
+                  crc, crc_checksum);
+
+    /* The shell only offers the name when the kernel is built */
+    enum crc_kernel kernel;
+
+    zassert_equal(crc32_kernel_from_name("forward", &kernel),
+                  IS_ENABLED(CONFIG_CRC32_FORWARD_KERNEL) ? 0 : -ENOTSUP);
+    zassert_equal(crc32_kernel_from_name("fwd", &kernel), -EINVAL);
+}
+
+ZTEST(crc_suite, crc32_clmul)
+{
+    static uint32_t buf[300];
+    uint32_t seed = 0x12345678;
+    size_t words_len = sizeof(test_data) / sizeof(test_data[0]);
+
+    uint32_t crc = crc32_bzip2_words_kernel(test_data, words_len, CRC_KERNEL_CLMUL);
+
+    zassert_equal(crc, crc_checksum,
+                  "CRC mismatch: got 0x%08X expected 0x%08X",
+                  crc, crc_checksum);
+
+    for (size_t i = 0; i < ARRAY_SIZE(buf); i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        buf[i] = seed;
+    }
+
+    /* Cover the 4-lane loop, the single-lane tail and the leftover words */
+    for (size_t len = 1; len <= ARRAY_SIZE(buf); len += 7)
+    {
+        uint32_t ref = crc32_bzip2_words_kernel(buf, len, CRC_KERNEL_BYTE);
+
+        crc = crc32_bzip2_words_kernel(buf, len, CRC_KERNEL_CLMUL);
+        zassert_equal(crc, ref, "len %u: got 0x%08X expected 0x%08X",
+                      (unsigned int)len, crc, ref);
+    }
+}
+
+ZTEST(crc_suite, crc32_stream_forward)
+{
+    static const uint8_t check[] = "123456789";
+    struct crc32_ctx ctx;
+
+    /* CRC-32/BZIP2 check value, fed one byte at a time */
+    crc32_ctx_init(&ctx, CRC32_ORDER_FORWARD);
+    for (size_t i = 0; i < sizeof(check) - 1; i++)
+    {
+        crc32_ctx_update(&ctx, &check[i], 1);
+    }
+
+    uint32_t crc = crc32_ctx_final(&ctx);
+
+    zassert_equal(crc, 0xFC891918,
+                  "CRC mismatch: got 0x%08X expected 0xFC891918", crc);
+}
+
+ZTEST(crc_suite, crc32_stream_reverse)
+{
+    const uint8_t *bytes = (const uint8_t *)test_data;
+    size_t len = sizeof(test_data);
+    size_t chunk = 1;
+    struct crc32_ctx ctx;
+
+    /* Chunks from the end of the region, sizes 1, 2, 3, ... bytes */
+    crc32_ctx_init(&ctx, CRC32_ORDER_REVERSE);
+    while (len > 0)
+    {
+        size_t n = MIN(chunk++, len);
+
+        len -= n;
+        crc32_ctx_update(&ctx, &bytes[len], n);
+    }
+
+    uint32_t crc = crc32_ctx_final(&ctx);
+
+    zassert_equal(crc, crc_checksum,
+                  "CRC mismatch: got 0x%08X expected 0x%08X",
+                  crc, crc_checksum);
+}
+
+ZTEST(crc_suite, crc32_bytes)
+{
+    static uint8_t buf[sizeof(test_data) + 8] __aligned(4);
+    size_t len = sizeof(test_data);
+    struct crc32_ctx ctx;
+    uint32_t crc;
+
+    /* Whole aligned words give the word result with every kernel */
+    for (int k = 0; k < CRC_KERNEL_COUNT; k++)
+    {
+        crc = crc32_bzip2_bytes_kernel((const uint8_t *)test_data, len, k);
+        zassert_equal(crc, crc_checksum, "%s: got 0x%08X", crc32_kernel_name(k), crc);
+    }
+
+    /* Every head/tail misalignment against the streaming reverse order */
+    for (size_t offset = 0; offset < 4; offset++)
+    {
+        memcpy(&buf[offset], test_data, len);
+
+        for (size_t n = len - 7; n <= len; n++)
+        {
+            crc32_ctx_init(&ctx, CRC32_ORDER_REVERSE);
+            crc32_ctx_update(&ctx, &buf[offset], n);
+            uint32_t ref = crc32_ctx_final(&ctx);
+
+            for (int k = 0; k < CRC_KERNEL_COUNT; k++)
+            {
+                crc = crc32_bzip2_bytes_kernel(&buf[offset], n, k);
+                zassert_equal(crc, ref, "%s offset %u len %u: got 0x%08X expected 0x%08X",
+                              crc32_kernel_name(k), (unsigned int)offset, (unsigned int)n,
+                              crc, ref);
+            }
+        }
+    }
+
+    /* Unaligned region with its trailer right behind it */
+    memcpy(&buf[1], test_data, len);
+    sys_put_le32(crc_checksum, &buf[1 + len]);
+
+    struct crc_result r = crc32_bytes_check((uint32_t)(uintptr_t)&buf[1], len, 1);
+
+    zassert_equal(r.status, CRC_OK, "trailer: got 0x%08X expected 0x%08X",
+                  r.crc, r.crc_ref);
+
+    r = crc32_bytes_check((uint32_t)(uintptr_t)&buf[1], 0, 0);
+    zassert_equal(r.status, CRC_INVALID, "empty region accepted");
+}
+
+ZTEST(crc_suite, crc32_segments)
+{
+    static uint8_t scattered[sizeof(test_data) + 64] __aligned(4);
+    static const uint8_t check[] = "123456789";
+    const uint8_t *bytes = (const uint8_t *)test_data;
+    size_t len = sizeof(test_data);
+    struct crc32_segment segs[3];
+    uint32_t crc;
+
+    /* Header, body and trailer at unrelated offsets, splits off word boundaries */
+    size_t cut1 = 13;
+    size_t cut2 = len - 37;
+
+    memcpy(&scattered[len + 3], bytes, cut1);
+    memcpy(&scattered[1], &bytes[cut1], cut2 - cut1);
+    memcpy(&scattered[len + 3 + cut1 + 5], &bytes[cut2], len - cut2);
+
+    segs[0] = (struct crc32_segment){ (uint32_t)(uintptr_t)&scattered[len + 3], cut1 };
+    segs[1] = (struct crc32_segment){ (uint32_t)(uintptr_t)&scattered[1], cut2 - cut1 };
+    segs[2] = (struct crc32_segment){ (uint32_t)(uintptr_t)&scattered[len + 3 + cut1 + 5],
+                                      len - cut2 };
+
+    zassert_ok(crc32_segments(segs, ARRAY_SIZE(segs), CRC32_ORDER_REVERSE, &crc));
+    zassert_equal(crc, crc_checksum, "reverse: got 0x%08X expected 0x%08X",
+                  crc, crc_checksum);
+
+    uint32_t ref = crc32_engine_compute(&crc32_variant_bzip2, bytes, len);
+
+    zassert_ok(crc32_segments(segs, ARRAY_SIZE(segs), CRC32_ORDER_FORWARD, &crc));
+    zassert_equal(crc, ref, "forward: got 0x%08X expected 0x%08X", crc, ref);
+
+    segs[0] = (struct crc32_segment){ (uint32_t)(uintptr_t)&check[0], 3 };
+    segs[1] = (struct crc32_segment){ (uint32_t)(uintptr_t)&check[3], 0 };
+    segs[2] = (struct crc32_segment){ (uint32_t)(uintptr_t)&check[3], 6 };
+
+    zassert_ok(crc32_segments(segs, ARRAY_SIZE(segs), CRC32_ORDER_FORWARD, &crc));
+    zassert_equal(crc, 0xFC891918, "check: got 0x%08X", crc);
+
+    segs[0] = (struct crc32_segment){ 0xFFFFFFF0u, 32 };
+    zassert_equal(crc32_segments(segs, 1, CRC32_ORDER_FORWARD, &crc), -EINVAL,
+                  "wrapping segment accepted");
+}
+
+ZTEST(crc_suite, crc32_combine)
+{
+    size_t words_len = sizeof(test_data) / sizeof(test_data[0]);
+    size_t split = 123;
+
+    /* The high words are hashed first, so they form the first block */
+    uint32_t crc_hi = crc32_bzip2_words_kernel(&test_data[split], words_len - split,
+                                               CRC_KERNEL_BYTE);
+    uint32_t crc_lo = crc32_bzip2_words_kernel(test_data, split, CRC_KERNEL_BYTE);
+
+    uint32_t crc = crc32_combine(crc_hi, crc_lo, split * sizeof(uint32_t));
+
+    zassert_equal(crc, crc_checksum,
+                  "CRC mismatch: got 0x%08X expected 0x%08X",
+                  crc, crc_checksum);
+}
+
+ZTEST(crc_suite, crc32_parallel)
+{
+    size_t words_len = sizeof(test_data) / sizeof(test_data[0]);
+
+    for (unsigned int slices = 1; slices <= CRC32_PARALLEL_SLICES_MAX; slices++)
+    {
+        uint32_t crc = crc32_bzip2_words_parallel(test_data, words_len, slices,
+                                                  CRC_KERNEL_DEFAULT);
+
+        zassert_equal(crc, crc_checksum,
+                      "CRC mismatch with %u slices: got 0x%08X expected 0x%08X",
+                      slices, crc, crc_checksum);
+    }
+}
+
+ZTEST(crc_suite, crc32_engine_variants)
+{
+    static const uint8_t check[] = "123456789";
+    static const struct
+    {
+        const struct crc32_variant *variant;
+        uint32_t check;
+    } vectors[] = {
+        { &crc32_variant_bzip2,    0xFC891918 },
+        { &crc32_variant_iso_hdlc, 0xCBF43926 },
+        { &crc32_variant_c,        0xE3069283 },
+        { &crc32_variant_mpeg2,    0x0376E6E7 },
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(vectors); i++)
+    {
+        const struct crc32_variant *v = vectors[i].variant;
+        uint32_t crc = crc32_engine_compute(v, check, sizeof(check) - 1);
+
+        zassert_equal(crc, vectors[i].check,
+                      "%s: got 0x%08X expected 0x%08X",
+                      v->name, crc, vectors[i].check);
+
+        /* Split at every offset and combine the two halves again */
+        for (size_t split = 0; split < sizeof(check); split++)
+        {
+            uint32_t crc1 = crc32_engine_compute(v, check, split);
+            uint32_t crc2 = crc32_engine_compute(v, &check[split],
+                                                 sizeof(check) - 1 - split);
+
+            crc = crc32_engine_combine(v, crc1, crc2, sizeof(check) - 1 - split);
+
+            zassert_equal(crc, vectors[i].check,
+                          "%s combine at %zu: got 0x%08X expected 0x%08X",
+                          v->name, split, crc, vectors[i].check);
+        }
+    }
+}
+
+ZTEST(crc_suite, crc32_manifest)
+{
+    static uint32_t with_trailer[ARRAY_SIZE(test_data) + 1];
+    static uint32_t blob_buf[2 + 4 * 4];
+    struct crc32_manifest_blob *blob = (struct crc32_manifest_blob *)blob_buf;
+    struct crc32_manifest_report report;
+    const struct crc32_manifest_entry *entries;
+    size_t count;
+
+    memcpy(with_trailer, test_data, sizeof(test_data));
+    with_trailer[ARRAY_SIZE(test_data)] = crc_checksum;
+
+    const struct crc32_manifest_entry manifest[] = {
+        { (uint32_t)(uintptr_t)test_data, ARRAY_SIZE(test_data), crc_checksum, 0 },
+        { (uint32_t)(uintptr_t)test_data, ARRAY_SIZE(test_data), crc_checksum ^ 1, 0 },
+        { (uint32_t)(uintptr_t)with_trailer, ARRAY_SIZE(test_data), 0,
+          CRC32_MANIFEST_TRAILING },
+        { (uint32_t)(uintptr_t)test_data + 1, 4, 0, 0 },
+    };
+
+    zassert_ok(crc32_manifest_verify(manifest, ARRAY_SIZE(manifest), &report));
+    zassert_equal(report.count, 4, "count %u", (unsigned int)report.count);
+    zassert_equal(report.passed, 2, "passed %u", (unsigned int)report.passed);
+    zassert_equal(report.pass[0], 0x5, "bitmap 0x%08X", report.pass[0]);
+
+    /* Same table as a blob in RAM */
+    blob->magic = CRC32_MANIFEST_MAGIC;
+    blob->count = ARRAY_SIZE(manifest);
+    memcpy(blob->entries, manifest, sizeof(manifest));
+
+    zassert_ok(crc32_manifest_from_blob((uint32_t)(uintptr_t)blob, &entries, &count));
+    zassert_equal(count, ARRAY_SIZE(manifest), "blob count %u", (unsigned int)count);
+    zassert_ok(crc32_manifest_verify(entries, count, &report));
+    zassert_equal(report.pass[0], 0x5, "blob bitmap 0x%08X", report.pass[0]);
+
+    blob->count = 0;
+    zassert_equal(crc32_manifest_from_blob((uint32_t)(uintptr_t)blob, &entries, &count),
+                  -EINVAL, "empty blob accepted");
+
+    blob->magic = 0;
+    zassert_equal(crc32_manifest_from_blob((uint32_t)(uintptr_t)blob, &entries, &count),
+                  -EINVAL, "bad magic accepted");
+}
+
+ZTEST(crc_suite, crc32_index)
+{
+    static uint32_t region[ARRAY_SIZE(test_data)];
+    size_t words_len = ARRAY_SIZE(test_data);
+    uint32_t address = (uint32_t)(uintptr_t)region;
+
+    CRC32_INDEX_DEFINE(idx, 8);
+
+    memcpy(region, test_data, sizeof(test_data));
+
+    /* 100-word blocks leave a short last block */
+    zassert_ok(crc32_index_build(&idx, address, words_len, 100));
+    zassert_equal(idx.crc, crc_checksum, "build: got 0x%08X", idx.crc);
+    zassert_equal(crc32_index_build(&idx, address, words_len, 64), -EINVAL,
+                  "more blocks than storage accepted");
+
+    zassert_ok(crc32_index_build(&idx, address, words_len, 128));
+    zassert_equal(idx.crc, crc_checksum, "build: got 0x%08X", idx.crc);
+
+    /* Update two words in different blocks, only those get re-read */
+    region[3] ^= 0x5A5A5A5A;
+    region[words_len - 1] ^= 0x1;
+    zassert_ok(crc32_index_mark_dirty(&idx, 3 * sizeof(uint32_t), sizeof(uint32_t)));
+    zassert_ok(crc32_index_mark_dirty(&idx, (words_len - 1) * sizeof(uint32_t), 4));
+    zassert_equal(crc32_index_refresh(&idx), 2, "dirty block count");
+
+    uint32_t ref = crc32_bzip2_words_kernel(region, words_len, CRC_KERNEL_BYTE);
+
+    zassert_equal(idx.crc, ref, "refresh: got 0x%08X expected 0x%08X", idx.crc, ref);
+
+    /* An unannounced change is found by sampling */
+    region[20] ^= 0x80000000;
+    zassert_equal(crc32_index_sample(&idx, idx.blocks), 1, "sampled mismatch count");
+
+    struct crc_result r = crc32_index_check(&idx, 0);
+
+    ref = crc32_bzip2_words_kernel(region, words_len, CRC_KERNEL_BYTE);
+    zassert_equal(r.crc, ref, "check: got 0x%08X expected 0x%08X", r.crc, ref);
+}
+
+static atomic_t scrub_reports;
+static uint32_t scrub_report_crc;
+
+static void scrub_report(const struct crc32_scrub_region *region, uint32_t crc)
+{
+    ARG_UNUSED(region);
+
+    scrub_report_crc = crc;
+    atomic_inc(&scrub_reports);
+}
+
+static bool scrub_wait_passes(uint32_t passes)
+{
+    struct crc32_scrub_status st;
+
+    for (int i = 0; i < 200; i++)
+    {
+        crc32_scrub_status_get(&st);
+        if (st.passes >= passes)
+        {
+            return true;
+        }
+
+        k_sleep(K_MSEC(10));
+    }
+
+    return false;
+}
+
+ZTEST(crc_suite, crc32_scrub)
+{
+    static uint32_t region[ARRAY_SIZE(test_data)];
+    struct crc32_scrub_status st;
+    struct crc32_scrub_region r;
+
+    memcpy(region, test_data, sizeof(test_data));
+
+    crc32_scrub_clear();
+    crc32_scrub_set_callback(scrub_report);
+    zassert_ok(crc32_scrub_set_budget(50, 1));
+    zassert_equal(crc32_scrub_set_budget(0, 1), -EINVAL, "zero duty accepted");
+    zassert_equal(crc32_scrub_add((uint32_t)(uintptr_t)region, ARRAY_SIZE(test_data),
+                                  crc_checksum), 0, "add failed");
+
+    crc32_scrub_start();
+    zassert_true(scrub_wait_passes(1), "no clean pass");
+    zassert_equal(atomic_get(&scrub_reports), 0, "clean region reported");
+
+    /* A flipped bit is reported on the next pass */
+    crc32_scrub_status_get(&st);
+    region[100] ^= 0x00010000;
+    zassert_true(scrub_wait_passes(st.passes + 2), "no pass after corruption");
+    crc32_scrub_stop();
+
+    zassert_true(atomic_get(&scrub_reports) > 0, "corruption not reported");
+    zassert_not_equal(scrub_report_crc, crc_checksum, "reported CRC is the golden one");
+    zassert_ok(crc32_scrub_region_get(0, &r));
+    zassert_true(r.failures > 0, "failure count not updated");
+
+    crc32_scrub_clear();
+}
+
+ZTEST(crc_suite, crc32_fused)
+{
+    static const uint8_t abc_sha256[SHA256_DIGEST_SIZE] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde,
+        0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+        0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+    };
+    /* test_data as little-endian bytes */
+    static const uint8_t data_sha256[SHA256_DIGEST_SIZE] = {
+        0x01, 0x7f, 0xc7, 0xa7, 0x15, 0x92, 0xf7, 0xd6, 0xf1, 0x5b, 0xc7, 0x67,
+        0x57, 0x58, 0xb1, 0x3c, 0x72, 0x78, 0xbf, 0xd4, 0x87, 0xfa, 0xb9, 0xb0,
+        0x10, 0x74, 0xdb, 0x4a, 0x1f, 0x69, 0xd8, 0xe6
+    };
+    struct sha256_ctx sha;
+    uint8_t digest[SHA256_DIGEST_SIZE];
+
+    sha256_init(&sha);
+    sha256_update(&sha, "abc", 3);
+    sha256_final(&sha, digest);
+    zassert_mem_equal(digest, abc_sha256, sizeof(digest), "SHA-256(abc) mismatch");
+
+    struct crc_fused_result r = crc32_words_check_fused((uint32_t)(uintptr_t)test_data,
+                                                        ARRAY_SIZE(test_data), 0,
+                                                        CRC32_DIGEST_ALL);
+
+    zassert_equal(r.status, CRC_UNUSED, "status %d", r.status);
+    zassert_equal(r.crc, crc_checksum, "bzip2: got 0x%08X", r.crc);
+    zassert_equal(r.crc32c, 0x4DC1C7EA, "crc32c: got 0x%08X", r.crc32c);
+    zassert_mem_equal(r.sha256, data_sha256, sizeof(r.sha256), "SHA-256 mismatch");
+
+    /* Only the requested digests are computed */
+    r = crc32_words_check_fused((uint32_t)(uintptr_t)test_data, ARRAY_SIZE(test_data), 0,
+                                CRC32_DIGEST_CRC32C);
+    zassert_equal(r.digests, CRC32_DIGEST_CRC32C, "digests 0x%x", r.digests);
+    zassert_equal(r.crc, 0, "bzip2 computed");
+    zassert_equal(r.crc32c, 0x4DC1C7EA, "crc32c: got 0x%08X", r.crc32c);
+}
+
+ZTEST(crc_suite, crc32_pipeline)
+{
+    static const struct crc32_pipeline_cfg cfgs[] = {
+        { 100, 2 },
+        { 7, 3 },
+        { 64, 4 },
+        { CRC32_PIPELINE_POOL_WORDS / 2, 2 },
+        { CRC32_PIPELINE_BUFFER_WORDS(3), 3 },
+    };
+    struct crc32_pipeline_stats st;
+    uint32_t crc;
+    size_t words_len = ARRAY_SIZE(test_data);
+
+    for (size_t i = 0; i < ARRAY_SIZE(cfgs); i++)
+    {
+        zassert_ok(crc32_bzip2_words_pipeline(test_data, words_len, &cfgs[i], &crc, &st));
+        zassert_equal(crc, crc_checksum, "chunk %u x %u: got 0x%08X",
+                      (unsigned int)cfgs[i].chunk_words, cfgs[i].buffers, crc);
+        zassert_equal(st.chunks, DIV_ROUND_UP(words_len, cfgs[i].chunk_words),
+                      "chunk count %u", (unsigned int)st.chunks);
+    }
+
+    zassert_ok(crc32_bzip2_words_pipeline(test_data, words_len, NULL, &crc, NULL));
+    zassert_equal(crc, crc_checksum, "defaults: got 0x%08X", crc);
+
+    const struct crc32_pipeline_cfg one_buffer = { 64, 1 };
+    const struct crc32_pipeline_cfg too_big = { CRC32_PIPELINE_POOL_WORDS / 2 + 1, 2 };
+    const struct crc32_pipeline_cfg past_line = { CRC32_PIPELINE_POOL_WORDS / 3, 3 };
+
+    zassert_equal(crc32_bzip2_words_pipeline(test_data, words_len, &one_buffer, &crc, NULL),
+                  -EINVAL, "single buffer accepted");
+    zassert_equal(crc32_bzip2_words_pipeline(test_data, words_len, &too_big, &crc, NULL),
+                  -EINVAL, "oversized chunks accepted");
+    zassert_equal(crc32_bzip2_words_pipeline(test_data, words_len, &past_line, &crc, NULL),
+                  -EINVAL, "chunk past the last whole cache line accepted");
+}
+
+ZTEST(crc_suite, crc32_syndrome)
+{
+    static uint32_t buf[ARRAY_SIZE(test_data) + 1];
+    static const uint32_t flips[][2] = {
+        { 0, 0 }, { 0, 31 }, { 5, 17 }, { ARRAY_SIZE(test_data) - 1, 31 },
+    };
+    size_t words_len = ARRAY_SIZE(test_data);
+    uint32_t address = (uint32_t)(uintptr_t)buf;
+    struct crc32_error_location loc;
+    struct crc_result r;
+
+    memcpy(buf, test_data, sizeof(test_data));
+    buf[words_len] = crc_checksum;
+
+    r = crc32_words_check_locate(address, words_len, true, &loc);
+    zassert_equal(r.status, CRC_OK, "clean region failed");
+    zassert_equal(loc.kind, CRC32_ERROR_NONE, "clean region located %d", loc.kind);
+
+    for (size_t i = 0; i < ARRAY_SIZE(flips); i++)
+    {
+        buf[flips[i][0]] ^= BIT(flips[i][1]);
+
+        r = crc32_words_check_locate(address, words_len, false, &loc);
+        zassert_equal(r.status, CRC_FAIL, "flip %u not detected", (unsigned int)i);
+        zassert_equal(loc.kind, CRC32_ERROR_SINGLE, "flip %u: kind %d", (unsigned int)i,
+                      loc.kind);
+        zassert_equal(loc.address[0], (uint32_t)(uintptr_t)&buf[flips[i][0]],
+                      "flip %u: address 0x%08X", (unsigned int)i, loc.address[0]);
+        zassert_equal(loc.bit[0], flips[i][1], "flip %u: bit %u", (unsigned int)i,
+                      loc.bit[0]);
+
+        r = crc32_words_check_locate(address, words_len, true, &loc);
+        zassert_true(loc.repaired, "flip %u not repaired", (unsigned int)i);
+        zassert_equal(r.status, CRC_OK, "flip %u: status %d after repair",
+                      (unsigned int)i, r.status);
+    }
+
+    zassert_mem_equal(buf, test_data, sizeof(test_data), "repair changed the data");
+
+    /* Two flips across a word boundary */
+    buf[9] ^= BIT(30);
+    buf[10] ^= BIT(3);
+
+    r = crc32_words_check_locate(address, words_len, true, &loc);
+    zassert_equal(loc.kind, CRC32_ERROR_DOUBLE, "double: kind %d", loc.kind);
+    zassert_equal(loc.address[0], (uint32_t)(uintptr_t)&buf[9], "double: first address");
+    zassert_equal(loc.bit[0], 30, "double: first bit %u", loc.bit[0]);
+    zassert_equal(loc.address[1], (uint32_t)(uintptr_t)&buf[10], "double: second address");
+    zassert_equal(loc.bit[1], 3, "double: second bit %u", loc.bit[1]);
+    zassert_equal(r.status, CRC_OK, "double: not repaired");
+
+    /* A flip in the stored CRC itself */
+    buf[words_len] ^= BIT(12);
+
+    r = crc32_words_check_locate(address, words_len, true, &loc);
+    zassert_equal(loc.kind, CRC32_ERROR_TRAILER, "trailer: kind %d", loc.kind);
+    zassert_equal(loc.bit[0], 12, "trailer: bit %u", loc.bit[0]);
+    zassert_equal(r.status, CRC_OK, "trailer: not repaired");
+    zassert_equal(buf[words_len], crc_checksum, "trailer: 0x%08X", buf[words_len]);
+}
+
+ZTEST(crc_suite, crc32_cache)
+{
+    static uint32_t buf[ARRAY_SIZE(test_data) + 1];
+    size_t words_len = ARRAY_SIZE(test_data);
+    uint32_t address = (uint32_t)(uintptr_t)buf;
+    struct crc32_cache_entry entry;
+    struct crc_result r;
+    bool hit;
+
+    memcpy(buf, test_data, sizeof(test_data));
+    buf[words_len] = crc_checksum;
+    crc32_cache_clear();
+
+    r = crc32_words_check_cached(address, words_len, 1, 7, &hit);
+    zassert_equal(r.status, CRC_OK, "first check failed");
+    zassert_false(hit, "empty cache hit");
+    zassert_ok(crc32_cache_entry_get(0, &entry));
+    zassert_equal(entry.crc, crc_checksum, "cached 0x%08X", entry.crc);
+
+    r = crc32_words_check_cached(address, words_len, 1, 7, &hit);
+    zassert_equal(r.status, CRC_OK, "cached check failed");
+    zassert_true(hit, "unchanged region missed");
+
+    /* A new image ID forces a full pass */
+    r = crc32_words_check_cached(address, words_len, 1, 8, &hit);
+    zassert_false(hit, "other image ID hit");
+
+    /* So does a change in a sampled word, and a failure is not cached */
+    buf[0] ^= 1;
+    r = crc32_words_check_cached(address, words_len, 1, 7, &hit);
+    zassert_equal(r.status, CRC_FAIL, "changed region passed");
+    zassert_false(hit, "changed region hit");
+    buf[0] ^= 1;
+
+    r = crc32_words_check_cached(address, words_len, 1, 7, &hit);
+    zassert_equal(r.status, CRC_OK, "restored region failed");
+    zassert_true(hit, "restored region missed");
+
+    /* Mode 0 returns the cached CRC */
+    r = crc32_words_check_cached(address, words_len, 0, 7, &hit);
+    zassert_false(hit, "mode 0 reused the mode 1 entry");
+    r = crc32_words_check_cached(address, words_len, 0, 7, &hit);
+    zassert_true(hit, "mode 0 missed");
+    zassert_equal(r.crc, crc_checksum, "mode 0: got 0x%08X", r.crc);
+    r = crc32_words_check_cached(address, words_len, 1, 7, &hit);
+    zassert_true(hit, "mode 0 entry replaced the mode 1 one");
+
+    crc32_cache_clear();
+    zassert_equal(crc32_cache_entry_get(0, &entry), -ENOENT, "entry left after clear");
+}
+
+K_SEM_DEFINE(job_done, 0, 4);
+static struct crc32_job_result job_results[4];
+
+static void job_complete(const struct crc32_job_result *result, void *user_data)
+{
+    job_results[(uintptr_t)user_data] = *result;
+    k_sem_give(&job_done);
+}
+
+ZTEST(crc_suite, crc32_job)
+{
+    static uint8_t big[256 * 1024];
+    const uint8_t *bytes = (const uint8_t *)test_data;
+    uint32_t base = (uint32_t)(uintptr_t)test_data;
+    struct crc32_job_region regions[] = {
+        { base, 20 },
+        { base + 20, 100 },
+        { base + 120, sizeof(test_data) - 120 },
+    };
+    struct crc32_job_stats st;
+    uint8_t bzip2 = 0;
+
+    while (crc32_variant_get(bzip2) != &crc32_variant_bzip2)
+    {
+        bzip2++;
+    }
+
+    crc32_job_stats_reset();
+
+    zassert_true(crc32_job_submit(regions, ARRAY_SIZE(regions), CRC32_JOB_VARIANT_WORDS,
+                                  job_complete, (void *)0) > 0, "words job rejected");
+    zassert_true(crc32_job_submit(regions, ARRAY_SIZE(regions), bzip2,
+                                  job_complete, (void *)1) > 0, "bzip2 job rejected");
+
+    zassert_ok(k_sem_take(&job_done, K_SECONDS(5)));
+    zassert_ok(k_sem_take(&job_done, K_SECONDS(5)));
+    zassert_equal(job_results[0].status, CRC32_JOB_DONE, "words job status");
+    zassert_equal(job_results[0].crc, crc_checksum, "words: got 0x%08X", job_results[0].crc);
+    zassert_equal(job_results[1].crc, crc32_engine_compute(&crc32_variant_bzip2, bytes,
+                                                           sizeof(test_data)),
+                  "bzip2: got 0x%08X", job_results[1].crc);
+    zassert_equal(job_results[1].bytes, sizeof(test_data), "bytes %u", job_results[1].bytes);
+
+    /* The second job is still queued behind the first when it is cancelled */
+    struct crc32_job_region large[] = {
+        { (uint32_t)(uintptr_t)big, sizeof(big) },
+    };
+
+    zassert_true(crc32_job_submit(large, 1, bzip2, job_complete, (void *)2) > 0,
+                 "large job rejected");
+
+    int id = crc32_job_submit(large, 1, bzip2, job_complete, (void *)3);
+
+    zassert_true(id > 0, "second large job rejected");
+    zassert_ok(crc32_job_cancel(id));
+    zassert_ok(k_sem_take(&job_done, K_SECONDS(5)));
+    zassert_ok(k_sem_take(&job_done, K_SECONDS(5)));
+    zassert_equal(job_results[2].status, CRC32_JOB_DONE, "large job status");
+    zassert_equal(job_results[3].status, CRC32_JOB_CANCELLED, "cancelled job status %d",
+                  job_results[3].status);
+
+    zassert_equal(crc32_job_cancel(id), -ENOENT, "finished job cancelled");
+    zassert_equal(crc32_job_submit(regions, 1, 0xFE, NULL, NULL), -EINVAL,
+                  "unknown variant accepted");
+
+    crc32_job_stats_get(&st);
+    zassert_equal(st.done, 3, "done %u", st.done);
+    zassert_equal(st.cancelled, 1, "cancelled %u", st.cancelled);
+    zassert_equal(st.pending, 0, "pending %u", st.pending);
+    zassert_equal(st.bytes, 2 * sizeof(test_data) + sizeof(big), "bytes");
+}
+
+ZTEST_SUITE(crc_suite, NULL, NULL, NULL, NULL, NULL);